@@ -26,6 +26,7 @@
 #include "version.h"
 
 extern "C" {
+#include <sys/resource.h>
 #include <unistd.h>
 }
 
@@ -100,6 +101,13 @@ int main(int argc, char *argv[])
     if (parser.isSet(debugOption))
         QueuedDebug::enableDebug();
 
+    // control files of running tasks are kept opened
+    struct rlimit files;
+    if ((::getrlimit(RLIMIT_NOFILE, &files) == 0) && (files.rlim_cur < files.rlim_max)) {
+        files.rlim_cur = files.rlim_max;
+        ::setrlimit(RLIMIT_NOFILE, &files);
+    }
+
     // build initial options hash
     QVariantHash arguments = {{"config", parser.value(configOption)}};
 
@@ -38,6 +38,19 @@ QVariantHash QueuedTcpServerResponseHelperTask::addOrEditTask(const long long _i
             [&output](const QueuedError &err) {
                 output = {{"code", 500}, {"message", err.message().c_str()}};
             });
+    } else if (_data.value("array", 0).toLongLong() > 0) {
+        // add array of new tasks
+        auto res = QueuedCoreAdaptor::sendTaskAddArray(defs, _data["array"].toLongLong(), _token);
+        res.match(
+            [&output](const QList<long long> &val) {
+                QVariantList ids;
+                for (auto id : val)
+                    ids.append(id);
+                output = {{"code", val.isEmpty() ? 500 : 200}, {"ids", ids}};
+            },
+            [&output](const QueuedError &err) {
+                output = {{"code", 500}, {"message", err.message().c_str()}};
+            });
     } else {
         // add new task
         auto res = QueuedCoreAdaptor::sendTaskAdd(defs, _token);
@@ -64,12 +77,19 @@ QueuedTcpServerResponseHelperTask::getDefinitions(const QVariantHash &_data)
     for (auto &arg : args)
         defs.arguments.append(arg.toString());
     defs.command = _data["command"].toString();
+    defs.deadline = QDateTime::fromString(_data["deadline"].toString(), Qt::ISODateWithMs);
+    auto dependencies = _data["dependencies"].toList();
+    for (auto &dependency : dependencies)
+        defs.dependencies.append(QueuedProcess::QueuedProcessDependency(dependency.toString()));
     defs.endTime = QDateTime::fromString(_data["end"].toString(), Qt::ISODateWithMs);
+    defs.gang = _data["gang"].toUInt();
     defs.gid = _data["gid"].toUInt();
     defs.nice = _data["nice"].toUInt();
+    defs.startAfter = QDateTime::fromString(_data["startAfter"].toString(), Qt::ISODateWithMs);
     defs.startTime = QDateTime::fromString(_data["start"].toString(), Qt::ISODateWithMs);
     defs.uid = _data["uid"].toUInt();
     defs.user = _data["user"].toLongLong();
+    defs.walltime = _data.value("walltime", -1).toLongLong();
     defs.workingDirectory = _data["workingDirectory"].toString();
     // limits
     QueuedLimits::Limits limits;
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2017 Queued team
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ *
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+
+
+#include "QueuedSimulator.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QTextStream>
+
+#include <queued/Queued.h>
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+
+#include "QueuedSimulatorProcessManager.h"
+
+
+QueuedSimulator::QueuedSimulator(QObject *parent, const QVariantHash &args)
+    : QObject(parent)
+{
+    qCDebug(LOG_APP) << __PRETTY_FUNCTION__;
+
+    QueuedSystemInfo::setSystemSize(args["cpu"].toLongLong(), args["memory"].toLongLong());
+
+    m_manager = new QueuedSimulatorProcessManager(this);
+    m_manager->setPolicy(static_cast<QueuedEnums::SchedulerPolicy>(args["policy"].toInt()));
+    connect(m_manager, &QueuedProcessManager::taskStartTimeReceived, this,
+            &QueuedSimulator::taskStarted);
+}
+
+
+QueuedSimulator::~QueuedSimulator()
+{
+    qCDebug(LOG_APP) << __PRETTY_FUNCTION__;
+}
+
+
+bool QueuedSimulator::load(const QString &_path)
+{
+    qCInfo(LOG_APP) << "Load trace from" << _path;
+
+    QFile file(_path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qCWarning(LOG_APP) << "Could not open trace" << _path;
+        return false;
+    }
+
+    QTextStream stream(&file);
+    long long number = 0;
+    while (!stream.atEnd()) {
+        auto line = stream.readLine().trimmed();
+        number++;
+        if (line.isEmpty() || line.startsWith('#'))
+            continue;
+
+        // submit runtime cpu memory user [nice] [walltime] [deadline]
+        auto fields = line.split(QRegExp("[\\s,]+"), QString::SkipEmptyParts);
+        while (fields.count() < 8)
+            fields.append("0");
+        bool status = true;
+        auto check = [&status](const bool _status) { status &= _status; };
+        bool ok = false;
+
+        QueuedSimulatorTask task;
+        task.submit = std::llround(fields.at(0).toDouble(&ok) * 1000.0);
+        check(ok);
+        task.runtime = std::llround(fields.at(1).toDouble(&ok) * 1000.0);
+        check(ok);
+        auto cpu = fields.at(2).toLongLong(&ok);
+        check(ok);
+        auto memory = QueuedLimits::convertMemory(fields.at(3), &ok);
+        check(ok);
+        task.limits = QueuedLimits::Limits(cpu, 0, memory, 0, 0);
+        task.user = fields.at(4).toLongLong(&ok);
+        check(ok);
+        task.nice = fields.at(5).toUInt(&ok);
+        check(ok);
+        task.walltime = std::llround(fields.at(6).toDouble(&ok));
+        check(ok);
+        task.deadline = std::llround(fields.at(7).toDouble(&ok) * 1000.0);
+        check(ok);
+        if (!status || (task.submit < 0) || (task.runtime < 0)) {
+            qCWarning(LOG_APP) << "Invalid trace line" << number << line;
+            return false;
+        }
+
+        m_tasks.append(task);
+    }
+
+    std::stable_sort(m_tasks.begin(), m_tasks.end(),
+                     [](const QueuedSimulatorTask &_first, const QueuedSimulatorTask &_second) {
+                         return _first.submit < _second.submit;
+                     });
+    qCInfo(LOG_APP) << "Loaded" << m_tasks.count() << "tasks";
+
+    return true;
+}
+
+
+QStringList QueuedSimulator::report() const
+{
+    auto first = m_tasks.isEmpty() ? 0 : m_tasks.first().submit;
+    auto makespan = m_end - first;
+
+    // reserved CPU time of started tasks
+    double busy = 0.0;
+    double wait = 0.0;
+    for (auto it = m_starts.cbegin(); it != m_starts.cend(); ++it) {
+        auto &task = m_tasks.at(it.key() - 1);
+        busy += static_cast<double>(QueuedProcessManager::requiredLimits(task.limits).cpu)
+                * task.runtime;
+        wait += it.value() - task.submit;
+    }
+    auto utilization
+        = (makespan > 0) ? busy / (QueuedSystemInfo::cpuCount() * makespan) * 100.0 : 0.0;
+    auto meanWait = m_starts.isEmpty() ? 0.0 : wait / m_starts.count();
+    auto statistics = m_manager->statistics();
+    auto passes = statistics["Scheduling pass"];
+
+    return {
+        QString("Tasks: %1, not started: %2")
+            .arg(m_tasks.count())
+            .arg(m_tasks.count() - m_starts.count()),
+        QString("Makespan: %1 s").arg(makespan / 1000.0, 0, 'f', 3),
+        QString("Utilization: %1 %").arg(utilization, 0, 'f', 2),
+        QString("Mean wait: %1 s").arg(meanWait / 1000.0, 0, 'f', 3),
+        QString("Deadlines: met %1, missed %2")
+            .arg(statistics["Deadlines"]["met"])
+            .arg(statistics["Deadlines"]["missed"]),
+        QString("Scheduler CPU time: %1 ms").arg(m_cost * 1000.0 / CLOCKS_PER_SEC, 0, 'f', 1),
+        QString("Scheduling passes: %1, p50 %2 us, p99 %3 us, max %4 us")
+            .arg(passes["count"])
+            .arg(passes["p50"])
+            .arg(passes["p99"])
+            .arg(passes["max"]),
+    };
+}
+
+
+void QueuedSimulator::run()
+{
+    qCInfo(LOG_APP) << "Replay" << m_tasks.count() << "tasks";
+
+    long long next = 0;
+    while (true) {
+        auto finish = m_manager->nextFinish();
+        if ((next >= m_tasks.count()) && (finish < 0))
+            break;
+        // jump to the nearest event
+        auto clock = (next < m_tasks.count()) ? m_tasks.at(next).submit : finish;
+        if (finish >= 0)
+            clock = std::min(clock, finish);
+        m_manager->setClock(clock);
+
+        QMap<long long, QueuedProcess::QueuedProcessDefinitions> definitions;
+        while ((next < m_tasks.count()) && (m_tasks.at(next).submit == clock)) {
+            auto &task = m_tasks.at(next++);
+            QueuedProcess::QueuedProcessDefinitions defs;
+            defs.command = "true";
+            defs.user = task.user;
+            defs.nice = task.nice;
+            defs.limits = task.limits.toString();
+            defs.walltime = task.walltime;
+            if (task.deadline > 0)
+                defs.deadline = m_manager->epoch().addMSecs(task.submit + task.deadline);
+            m_manager->setRuntime(next, task.runtime);
+            definitions[next] = defs;
+        }
+
+        // ended tasks release resources before new ones are submitted
+        auto cpu = std::clock();
+        m_manager->finishTasks();
+        if (!definitions.isEmpty())
+            m_manager->add(definitions);
+        m_cost += std::clock() - cpu;
+
+        // processes of ended tasks are deleted later
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+
+    // tasks which do not fit into system are never started
+    m_end = m_manager->clock();
+    qCInfo(LOG_APP) << "Replay has been finished at" << m_end;
+}
+
+
+void QueuedSimulator::taskStarted(const long long _index, const QDateTime &_time)
+{
+    m_starts[_index] = m_manager->epoch().msecsTo(_time);
+}
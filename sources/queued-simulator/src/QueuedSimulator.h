@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2017 Queued team
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ *
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+
+
+#ifndef QUEUEDSIMULATOR_H
+#define QUEUEDSIMULATOR_H
+
+#include <QObject>
+#include <QVariant>
+
+#include <queued/QueuedLimits.h>
+
+
+class QueuedSimulatorProcessManager;
+
+class QueuedSimulator : public QObject
+{
+    Q_OBJECT
+
+public:
+    // times are in msecs since trace start
+    struct QueuedSimulatorTask {
+        long long submit = 0;
+        long long runtime = 0;
+        long long walltime = 0;
+        // relative to submit time, 0 if there is no deadline
+        long long deadline = 0;
+        long long user = 0;
+        uint nice = 0;
+        QueuedLimits::Limits limits;
+    };
+
+    explicit QueuedSimulator(QObject *parent, const QVariantHash &args);
+    virtual ~QueuedSimulator();
+    bool load(const QString &_path);
+    QStringList report() const;
+    void run();
+
+private slots:
+    void taskStarted(const long long _index, const QDateTime &_time);
+
+private:
+    QueuedSimulatorProcessManager *m_manager = nullptr;
+    // CPU time consumed by scheduler in clock ticks
+    long long m_cost = 0;
+    long long m_end = 0;
+    QHash<long long, long long> m_starts;
+    // tasks ordered by submit time, task index is position in list plus one
+    QList<QueuedSimulatorTask> m_tasks;
+};
+
+
+#endif /* QUEUEDSIMULATOR_H */
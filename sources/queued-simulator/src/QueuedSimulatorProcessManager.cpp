@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2017 Queued team
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ *
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+
+
+#include "QueuedSimulatorProcessManager.h"
+
+#include <queued/Queued.h>
+
+
+QueuedSimulatorProcessManager::QueuedSimulatorProcessManager(QObject *parent)
+    : QueuedProcessManager(parent)
+{
+    qCDebug(LOG_APP) << __PRETTY_FUNCTION__;
+
+    // fixed epoch keeps decisions which depend on dates reproducible
+    m_epoch = QDateTime(QDate(2000, 1, 1), QTime(0, 0), Qt::UTC);
+}
+
+
+QueuedSimulatorProcessManager::~QueuedSimulatorProcessManager()
+{
+    qCDebug(LOG_APP) << __PRETTY_FUNCTION__;
+}
+
+
+long long QueuedSimulatorProcessManager::clock() const
+{
+    return m_clock;
+}
+
+
+QDateTime QueuedSimulatorProcessManager::epoch() const
+{
+    return m_epoch;
+}
+
+
+void QueuedSimulatorProcessManager::finishTasks()
+{
+    // tasks without runtime are started and finished at the same time
+    while (!m_finishes.isEmpty() && (m_finishes.firstKey() <= m_clock)) {
+        auto task = m_finishes.first();
+        m_finishes.erase(m_finishes.begin());
+        auto pr = process(task.first);
+        if (!pr || (m_launches.value(task.first) != task.second))
+            continue;
+        qCDebug(LOG_APP) << "Finish task" << task.first << "at" << m_clock;
+        // the manager handles process end by the signal only
+        emit(pr->finished(0, QProcess::ExitStatus::NormalExit));
+    }
+}
+
+
+long long QueuedSimulatorProcessManager::nextFinish() const
+{
+    return m_finishes.isEmpty() ? -1 : m_finishes.firstKey();
+}
+
+
+void QueuedSimulatorProcessManager::setClock(const long long _clock)
+{
+    m_clock = _clock;
+}
+
+
+void QueuedSimulatorProcessManager::setRuntime(const long long _index, const long long _runtime)
+{
+    m_runtimes[_index] = _runtime;
+}
+
+
+QDateTime QueuedSimulatorProcessManager::currentTime() const
+{
+    return m_epoch.addMSecs(m_clock);
+}
+
+
+void QueuedSimulatorProcessManager::startProcess(QueuedProcess *_process)
+{
+    auto index = _process->index();
+    auto launch = ++m_launches[index];
+    m_finishes.insert(m_clock + m_runtimes.value(index), {index, launch});
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2017 Queued team
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ *
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+
+
+#ifndef QUEUEDSIMULATORPROCESSMANAGER_H
+#define QUEUEDSIMULATORPROCESSMANAGER_H
+
+#include <QMultiMap>
+
+#include <queued/QueuedProcessManager.h>
+
+
+class QueuedSimulatorProcessManager : public QueuedProcessManager
+{
+    Q_OBJECT
+
+public:
+    explicit QueuedSimulatorProcessManager(QObject *parent);
+    virtual ~QueuedSimulatorProcessManager();
+    // time in msecs since simulation start
+    long long clock() const;
+    QDateTime epoch() const;
+    void finishTasks();
+    // time of the next task end or -1 if there are no running tasks
+    long long nextFinish() const;
+    void setClock(const long long _clock);
+    void setRuntime(const long long _index, const long long _runtime);
+
+protected:
+    QDateTime currentTime() const override;
+    void startProcess(QueuedProcess *_process) override;
+
+private:
+    long long m_clock = 0;
+    QDateTime m_epoch;
+    // task end times mapped to index and launch number, the last one is used to skip ends of
+    // requeued tasks
+    QMultiMap<long long, QPair<long long, long long>> m_finishes;
+    QHash<long long, long long> m_launches;
+    QHash<long long, long long> m_runtimes;
+};
+
+
+#endif /* QUEUEDSIMULATORPROCESSMANAGER_H */
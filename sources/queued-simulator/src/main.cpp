@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2017 Queued team
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ *
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+
+#include <queued/Queued.h>
+
+#include <iostream>
+
+#include "QueuedSimulator.h"
+#include "version.h"
+
+
+int main(int argc, char *argv[])
+{
+    QueuedDebug::applyLogFormat();
+    // scheduler iterates over hashes in some places, fixed seed keeps replay reproducible
+    qSetGlobalQHashSeed(0);
+
+    QCoreApplication app(argc, argv);
+    app.setApplicationName(NAME);
+    app.setApplicationVersion(VERSION);
+
+    // parser
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Replay workload trace against scheduler without starting "
+                                     "real processes");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument(
+        "trace", "Workload trace, each line contains submit time and runtime in seconds, CPU "
+                 "cores, memory, user ID and optional nice level, walltime and deadline after "
+                 "submit in seconds.");
+
+    // system size
+    QCommandLineOption cpuOption("cpu", "Simulated CPU count, actual one is used if not set.",
+                                 "cpu", "0");
+    parser.addOption(cpuOption);
+    QCommandLineOption memoryOption(
+        "memory", "Simulated memory, e.g. 64G, actual one is used if not set.", "memory", "0");
+    parser.addOption(memoryOption);
+
+    // scheduler
+    QCommandLineOption policyOption("policy", "Scheduler policy.", "policy", "priority");
+    parser.addOption(policyOption);
+
+    // debug mode
+    QCommandLineOption debugOption({"d", "debug"}, "Print debug information.");
+    parser.addOption(debugOption);
+
+    parser.process(app);
+
+    if (parser.positionalArguments().count() != 1)
+        parser.showHelp(1);
+    // enable debug
+    if (parser.isSet(debugOption))
+        QueuedDebug::enableDebug();
+
+    auto policy = QueuedEnums::stringToSchedulerPolicy(parser.value(policyOption));
+    if (policy == QueuedEnums::SchedulerPolicy::Invalid) {
+        qCWarning(LOG_APP) << "Invalid policy" << parser.value(policyOption);
+        return 1;
+    }
+
+    // build initial options hash
+    QVariantHash arguments
+        = {{"cpu", parser.value(cpuOption).toLongLong()},
+           {"memory", QueuedLimits::convertMemory(parser.value(memoryOption))},
+           {"policy", static_cast<int>(policy)}};
+
+    QueuedSimulator simulator(nullptr, arguments);
+    if (!simulator.load(parser.positionalArguments().first()))
+        return 1;
+    simulator.run();
+
+    auto report = simulator.report();
+    for (auto &string : report)
+        std::cout << qPrintable(string) << std::endl;
+    return 0;
+}
@@ -34,6 +34,7 @@
 #include "QueuedDebug.h"
 #include "QueuedEnums.h"
 #include "QueuedExceptions.h"
+#include "QueuedHistogram.h"
 #include "QueuedLimits.h"
 #include "QueuedPluginInterface.h"
 #include "QueuedPluginManager.h"
@@ -45,10 +46,12 @@
 #include "QueuedReportInterface.h"
 #include "QueuedReportManager.h"
 #include "QueuedResult.h"
+#include "QueuedSchedulerPolicy.h"
 #include "QueuedSettings.h"
 #include "QueuedStaticConfig.h"
 #include "QueuedSystemInfo.h"
 #include "QueuedTokenManager.h"
+#include "QueuedUsageHistory.h"
 #include "QueuedUser.h"
 #include "QueuedUserManager.h"
 
@@ -24,6 +24,7 @@
 #ifndef QUEUEDCONTROLGROUPSADAPTOR_H
 #define QUEUEDCONTROLGROUPSADAPTOR_H
 
+#include <QHash>
 #include <QObject>
 
 
@@ -36,34 +37,136 @@ class QueuedControlGroupsAdaptor : public QObject
     // static
     Q_PROPERTY(QStringList controlPaths READ controlPaths)
     Q_PROPERTY(QString cpuPath READ cpuPath)
+    Q_PROPERTY(bool cpusetAvailable READ cpusetAvailable)
+    Q_PROPERTY(QString cpusetPath READ cpusetPath)
     Q_PROPERTY(QString memoryPath READ memoryPath)
+    Q_PROPERTY(bool unified READ unified)
     // dynamic
+    Q_PROPERTY(QString eventsFile READ eventsFile)
     Q_PROPERTY(QString name READ name)
     Q_PROPERTY(long long cpuLimit READ cpuLimit WRITE setCpuLimit)
+    Q_PROPERTY(QList<long long> cpuSet READ cpuSet WRITE setCpuSet)
+    Q_PROPERTY(long long cpuUsage READ cpuUsage)
+    Q_PROPERTY(long long ioUsage READ ioUsage)
+    Q_PROPERTY(QString memoryEventsFile READ memoryEventsFile)
     Q_PROPERTY(long long memoryLimit READ memoryLimit WRITE setMemoryLimit)
+    Q_PROPERTY(long long memoryPeak READ memoryPeak)
+    Q_PROPERTY(QList<long long> memorySet READ memorySet WRITE setMemorySet)
+    Q_PROPERTY(long long memoryUsage READ memoryUsage)
+    Q_PROPERTY(long long oomKills READ oomKills)
+    Q_PROPERTY(long long pidsCount READ pidsCount)
+    Q_PROPERTY(bool populated READ populated)
 
 public:
     // constants
     /**
      * @brief name of file contains cpu limit
      */
-    const char *CG_CPU_LIMIT = "cpu.cfs_quota_us";
+    static constexpr const char *CG_CPU_LIMIT = "cpu.cfs_quota_us";
+    /**
+     * @brief name of file contains cpu limit in unified hierarchy
+     */
+    static constexpr const char *CG_CPU_MAX = "cpu.max";
+    /**
+     * @brief name of file contains CPU quota period
+     */
+    static constexpr const char *CG_CPU_PERIOD = "cpu.cfs_period_us";
+    /**
+     * @brief name of file contains CPU statistics in unified hierarchy
+     */
+    static constexpr const char *CG_CPU_STAT = "cpu.stat";
+    /**
+     * @brief name of file contains consumed CPU time
+     */
+    static constexpr const char *CG_CPU_USAGE = "cpuacct.usage";
+    /**
+     * @brief name of file contains allowed CPU cores
+     */
+    static constexpr const char *CG_CPUSET_CPUS = "cpuset.cpus";
+    /**
+     * @brief name of file contains allowed memory nodes
+     */
+    static constexpr const char *CG_CPUSET_MEMS = "cpuset.mems";
+    /**
+     * @brief name of file contains available controllers in unified hierarchy
+     */
+    static constexpr const char *CG_CONTROLLERS_FILE = "cgroup.controllers";
+    /**
+     * @brief name of leaf group to which daemon is moved in delegated subtree
+     */
+    static constexpr const char *CG_DAEMON_GROUP = "queued-daemon";
+    /**
+     * @brief name of file contains group events in unified hierarchy
+     */
+    static constexpr const char *CG_EVENTS_FILE = "cgroup.events";
+    /**
+     * @brief name of file contains IO statistics in unified hierarchy
+     */
+    static constexpr const char *CG_IO_STAT = "io.stat";
+    /**
+     * @brief name of file which kills all group processes in unified hierarchy
+     */
+    static constexpr const char *CG_KILL_FILE = "cgroup.kill";
+    /**
+     * @brief name of file contains memory throttling threshold in unified hierarchy
+     */
+    static constexpr const char *CG_MEMORY_HIGH = "memory.high";
     /**
      * @brief name of file contains memory limit
      */
-    const char *CG_MEMORY_LIMIT = "memory.limit_in_bytes";
+    static constexpr const char *CG_MEMORY_LIMIT = "memory.limit_in_bytes";
+    /**
+     * @brief name of file contains memory limit in unified hierarchy
+     */
+    static constexpr const char *CG_MEMORY_MAX = "memory.max";
+    /**
+     * @brief name of file contains memory events counters in unified hierarchy
+     */
+    static constexpr const char *CG_MEMORY_EVENTS = "memory.events";
+    /**
+     * @brief name of file contains the highest memory usage
+     */
+    static constexpr const char *CG_MEMORY_MAX_USAGE = "memory.max_usage_in_bytes";
+    /**
+     * @brief name of file contains OOM killer state
+     */
+    static constexpr const char *CG_MEMORY_OOM_CONTROL = "memory.oom_control";
+    /**
+     * @brief name of file contains the highest memory usage in unified hierarchy
+     */
+    static constexpr const char *CG_MEMORY_PEAK = "memory.peak";
+    /**
+     * @brief name of file contains memory statistics
+     */
+    static constexpr const char *CG_MEMORY_STAT = "memory.stat";
     /**
      * @brief name of file contains notify status
      */
-    const char *CG_NOTIFY_ON_RELEASE_FILE = "notify_on_release";
+    static constexpr const char *CG_NOTIFY_ON_RELEASE_FILE = "notify_on_release";
+    /**
+     * @brief name of file contains count of processes in unified hierarchy
+     */
+    static constexpr const char *CG_PIDS_CURRENT = "pids.current";
     /**
      * @brief name of file contains processes list
      */
-    const char *CG_PROC_FILE = "cgroup.procs";
+    static constexpr const char *CG_PROC_FILE = "cgroup.procs";
     /**
      * @brief name of file contains release command
      */
-    const char *CG_RELEASE_FILE = "release_agent";
+    static constexpr const char *CG_RELEASE_FILE = "release_agent";
+    /**
+     * @brief name of file contains controllers enabled for child groups in unified hierarchy
+     */
+    static constexpr const char *CG_SUBTREE_CONTROL_FILE = "cgroup.subtree_control";
+    /**
+     * @brief CPU quota period in microseconds
+     */
+    static constexpr long long CPU_PERIOD = 100000;
+    /**
+     * @brief share of memory limit after which group is throttled and reclaimed
+     */
+    static constexpr double MEMORY_HIGH_RATIO = 0.9;
 
     /**
      * @brief QueuedControlGroupsAdaptor class constructor
@@ -86,8 +189,9 @@ public:
     QString groupPath(const QString &_base) const;
     // static properties
     /**
-     * @brief paths to all control directories
-     * @return full paths to all known control directories
+     * @brief paths to control directories which are used by every group
+     * @remark cpuset control is optional in legacy hierarchy, thus it is not included
+     * @return full paths to required control directories
      */
     static QStringList controlPaths();
     /**
@@ -95,39 +199,149 @@ public:
      * @return full path to CPU control directory
      */
     static QString cpuPath();
+    /**
+     * @brief cpuset control state
+     * @return true if cpuset control is mounted and writable
+     */
+    static bool cpusetAvailable();
+    /**
+     * @brief path to cpuset control
+     * @return full path to cpuset control directory
+     */
+    static QString cpusetPath();
     /**
      * @brief path to memory control
      * @return full path to memory control directory
      */
     static QString memoryPath();
+    /**
+     * @brief prepare delegated subtree of unified hierarchy to create task groups
+     * @remark daemon is moved to leaf group, because processes may not be placed to group which
+     * distributes resources, and all available controllers are enabled for child groups. Legacy
+     * hierarchy does not require preparation
+     * @return preparation status
+     */
+    static bool prepareHierarchy();
+    /**
+     * @brief unified hierarchy usage
+     * @return true if cgroup v2 is mounted
+     */
+    static bool unified();
+    /**
+     * @brief path to delegated subtree of unified hierarchy
+     * @return full path to group in which daemon has been started
+     */
+    static QString unifiedPath();
     // instance depended properties
     /**
      * @brief CPU limit
-     * @return current CPU limit level
+     * @return count of CPU cores available for group processes, 0 if group is not limited
      */
     long long cpuLimit() const;
+    /**
+     * @brief CPU cores
+     * @return list of CPU cores allowed for group processes
+     */
+    QList<long long> cpuSet() const;
+    /**
+     * @brief CPU usage
+     * @return CPU time consumed by group processes in nanoseconds
+     */
+    long long cpuUsage() const;
+    /**
+     * @brief cpuset group state
+     * @return true if group has cpuset control
+     */
+    bool cpusetEnabled() const;
+    /**
+     * @brief group events file
+     * @remark file is modified on group state change, thus it may be watched by inotify
+     * @return full path to events file, empty string in legacy hierarchy
+     */
+    QString eventsFile() const;
+    /**
+     * @brief IO usage
+     * @return bytes read and written by group processes, always 0 in legacy hierarchy
+     */
+    long long ioUsage() const;
+    /**
+     * @brief memory events file
+     * @remark file is modified on memory events including OOM kills, thus it may be watched by
+     * inotify
+     * @return full path to memory events file, empty string in legacy hierarchy
+     */
+    QString memoryEventsFile() const;
     /**
      * @brief memory limit
      * @return current memory limit level
      */
     long long memoryLimit() const;
+    /**
+     * @brief memory peak
+     * @return the highest memory usage of group in bytes
+     */
+    long long memoryPeak() const;
+    /**
+     * @brief memory nodes
+     * @return list of NUMA nodes allowed for group memory allocations
+     */
+    QList<long long> memorySet() const;
+    /**
+     * @brief memory usage
+     * @return resident memory of group processes in bytes
+     */
+    long long memoryUsage() const;
     /**
      * @brief control group name
      * @return control group name
      */
     QString name() const;
+    /**
+     * @brief OOM kills
+     * @return count of group processes killed by OOM killer
+     */
+    long long oomKills() const;
+    /**
+     * @brief processes count
+     * @return count of group processes
+     */
+    long long pidsCount() const;
+    /**
+     * @brief paths to control directories of group
+     * @return full paths to control directories which contain group
+     */
+    QStringList paths() const;
+    /**
+     * @brief group state
+     * @return true if group or its children contain processes
+     */
+    bool populated() const;
     /**
      * @brief set CPU limit
      * @param _value
-     * new CPU limit level
+     * count of CPU cores available for group processes, 0 to remove limit
      */
     void setCpuLimit(const long long _value);
+    /**
+     * @brief set CPU cores
+     * @param _cpus
+     * list of CPU cores allowed for group processes
+     * @remark cpuset group is created on the first call
+     */
+    void setCpuSet(const QList<long long> &_cpus);
     /**
      * @brief set memory limit
      * @param _value
      * new memory limit level
      */
     void setMemoryLimit(const long long _value);
+    /**
+     * @brief set memory nodes
+     * @param _nodes
+     * list of NUMA nodes allowed for group memory allocations
+     * @remark cpuset group is created on the first call
+     */
+    void setMemorySet(const QList<long long> &_nodes);
     // methods
     /**
      * @brief assign control group to process
@@ -138,13 +352,36 @@ public:
      * @return process assignment status
      */
     bool addProcess(const uint _pid);
+    /**
+     * @brief move calling process to group
+     * @param _files
+     * descriptors of opened process list files
+     * @remark method is async-signal-safe, thus it may be called in forked child
+     * @return process assignment status
+     */
+    static bool addSelf(const QList<int> &_files);
     /**
      * @brief create empty group
      * @param _name
      * control group name
+     * @remark groups are created in all required controls even if some of them have failed
      * @return group creation status
      */
     bool createGroup();
+    /**
+     * @brief add cpuset control to group
+     * @remark cpuset group gets all CPU cores and memory nodes of parent one, processes which
+     * are already in group are moved to it. Unified hierarchy does not require it
+     * @return true if group has cpuset control
+     */
+    bool enableCpuSet();
+    /**
+     * @brief process list files of all group controls opened for writing
+     * @remark descriptors are owned by adaptor and closed on exec, controls which could not be
+     * opened are skipped
+     * @return list of file descriptors or empty list on error
+     */
+    QList<int> processFiles() const;
     /**
      * @brief remove control group
      * @param _name
@@ -152,13 +389,89 @@ public:
      * @return group removal status
      */
     bool removeGroup();
+    /**
+     * @brief send signal to all group processes
+     * @param _signal
+     * signal number
+     * @remark processes are killed by kernel at once if cgroup.kill is available, otherwise
+     * they are signalled one by one from process list
+     * @return true if all processes have been signalled
+     */
+    bool sendSignal(const int _signal) const;
 
 private:
     // properties
+    /**
+     * @brief group has cpuset control in legacy hierarchy
+     */
+    bool m_cpuset = false;
+    /**
+     * @brief opened control files mapped by path and open flags
+     */
+    mutable QHash<QPair<QString, int>, int> m_files;
     /**
      * @brief control group name
      */
     QString m_name;
+    // methods
+    /**
+     * @brief enable release agent of group in legacy hierarchy
+     * @param _base
+     * full path to base directory
+     * @return rules apply status
+     */
+    bool applyReleaseRules(const QString &_base) const;
+    /**
+     * @brief close all opened control files
+     */
+    void closeFiles();
+    /**
+     * @brief build path to control file of group
+     * @param _base
+     * full path to base directory
+     * @param _file
+     * control file name
+     * @return full path to control file
+     */
+    QString controlFile(const QString &_base, const char *_file) const;
+    /**
+     * @brief get descriptor of control file
+     * @param _path
+     * full path to control file
+     * @param _flags
+     * open flags
+     * @remark file is opened on the first access and kept opened until group removal
+     * @return file descriptor or -1 on error
+     */
+    int descriptor(const QString &_path, const int _flags) const;
+    /**
+     * @brief read whole control file
+     * @param _path
+     * full path to control file
+     * @param _value
+     * file content
+     * @return read status
+     */
+    bool readFile(const QString &_path, QByteArray &_value) const;
+    /**
+     * @brief write value to control file which is not related to group
+     * @param _path
+     * full path to control file
+     * @param _value
+     * value to write
+     * @remark file is opened for single write, errno is kept on error
+     * @return write status
+     */
+    static bool writeControl(const QString &_path, const QByteArray &_value);
+    /**
+     * @brief write value to control file by single call
+     * @param _path
+     * full path to control file
+     * @param _value
+     * value to write
+     * @return write status
+     */
+    bool writeFile(const QString &_path, const QByteArray &_value) const;
 };
 
 
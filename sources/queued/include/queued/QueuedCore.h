@@ -72,6 +72,26 @@ public:
      * @return true on successfully addition
      */
     QueuedResult<bool> addPlugin(const QString &_plugin, const QString &_token);
+    /**
+     * @brief add resources reservation
+     * @param _user
+     * user ID who may use reserved resources, 0 for maintenance window
+     * @param _limits
+     * reserved resources, zero values mean the whole machine
+     * @param _start
+     * start of the first window
+     * @param _end
+     * end of the first window
+     * @param _period
+     * window repeat period in seconds, 0 for single window
+     * @param _token
+     * user auth token
+     * @return reservation ID or -1 if no reservation added
+     */
+    QueuedResult<long long> addReservation(const long long _user,
+                                           const QueuedLimits::Limits &_limits,
+                                           const QDateTime &_start, const QDateTime &_end,
+                                           const long long _period, const QString &_token);
     /**
      * @brief add new task
      * @param _command
@@ -86,6 +106,16 @@ public:
      * task nice level
      * @param _limits
      * task defined limits
+     * @param _walltime
+     * estimated task run time in seconds
+     * @param _gang
+     * count of cooperating processes which require dedicated CPU cores, 0 to disable
+     * @param _startAfter
+     * time before which task may not be started, invalid to start any time
+     * @param _deadline
+     * time by which task should be finished, invalid if there is no deadline
+     * @param _dependencies
+     * task dependencies in type:task format
      * @param _token
      * user auth token
      * @return task ID or -1 if no task added
@@ -93,7 +123,46 @@ public:
     QueuedResult<long long> addTask(const QString &_command, const QStringList &_arguments,
                                     const QString &_workingDirectory, const long long _userId,
                                     const uint _nice, const QueuedLimits::Limits &_limits,
-                                    const QString &_token);
+                                    const long long _walltime, const uint _gang,
+                                    const QDateTime &_startAfter, const QDateTime &_deadline,
+                                    const QStringList &_dependencies, const QString &_token);
+    /**
+     * @brief add new array task
+     * @param _command
+     * command line
+     * @param _arguments
+     * command arguments
+     * @param _workingDirectory
+     * working directory
+     * @param _userId
+     * task owner user ID
+     * @param _nice
+     * task nice level
+     * @param _limits
+     * task defined limits
+     * @param _walltime
+     * estimated task run time in seconds
+     * @param _gang
+     * count of cooperating processes which require dedicated CPU cores, 0 to disable
+     * @param _startAfter
+     * time before which task may not be started, invalid to start any time
+     * @param _deadline
+     * time by which task should be finished, invalid if there is no deadline
+     * @param _dependencies
+     * task dependencies in type:task format
+     * @param _count
+     * number of tasks in array
+     * @param _token
+     * user auth token
+     * @return list of task IDs
+     */
+    QueuedResult<QList<long long>>
+    addTaskArray(const QString &_command, const QStringList &_arguments,
+                 const QString &_workingDirectory, const long long _userId, const uint _nice,
+                 const QueuedLimits::Limits &_limits, const long long _walltime,
+                 const uint _gang, const QDateTime &_startAfter, const QDateTime &_deadline,
+                 const QStringList &_dependencies, const long long _count,
+                 const QString &_token);
     /**
      * @brief add new user
      * @param _name
@@ -243,6 +312,20 @@ public:
      * @return true on successful plugin removal
      */
     QueuedResult<bool> removePlugin(const QString &_plugin, const QString &_token);
+    /**
+     * @brief remove resources reservation
+     * @param _id
+     * reservation ID
+     * @param _token
+     * user auth token
+     * @return true on successful reservation removal
+     */
+    QueuedResult<bool> removeReservation(const long long _id, const QString &_token);
+    /**
+     * @brief scheduler latency statistics
+     * @return histogram summaries mapped by section name
+     */
+    QueuedStatusMap schedulerStatistics() const;
     /**
      * @brief force start task
      * @param _id
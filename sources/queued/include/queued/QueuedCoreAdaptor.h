@@ -96,6 +96,35 @@ QueuedResult<bool> sendPluginAdd(const QString &_plugin, const QString &_token);
  * @return true on successful plugin removal
  */
 QueuedResult<bool> sendPluginRemove(const QString &_plugin, const QString &_token);
+/**
+ * @brief send ReservationAdd
+ * @param _user
+ * user ID, 0 for maintenance window
+ * @param _limits
+ * reserved resources, only CPU cores and memory are used
+ * @param _start
+ * start of the first window
+ * @param _end
+ * end of the first window
+ * @param _period
+ * window repeat period in seconds, 0 for single window
+ * @param _token
+ * auth user token
+ * @return reservation ID or {0, -1} if no reservation added
+ */
+QueuedResult<long long> sendReservationAdd(const long long _user,
+                                           const QueuedLimits::Limits &_limits,
+                                           const QDateTime &_start, const QDateTime &_end,
+                                           const long long _period, const QString &_token);
+/**
+ * @brief send ReservationRemove
+ * @param _id
+ * reservation ID
+ * @param _token
+ * auth user token
+ * @return true on successful reservation removal
+ */
+QueuedResult<bool> sendReservationRemove(const long long _id, const QString &_token);
 /**
  * @brief send TaskAdd
  * @param _definitions
@@ -106,6 +135,19 @@ QueuedResult<bool> sendPluginRemove(const QString &_plugin, const QString &_toke
  */
 QueuedResult<long long> sendTaskAdd(const QueuedProcess::QueuedProcessDefinitions &_definitions,
                                     const QString &_token);
+/**
+ * @brief send TaskAddArray
+ * @param _definitions
+ * process definitions
+ * @param _count
+ * number of tasks in array
+ * @param _token
+ * auth user token
+ * @return list of task IDs
+ */
+QueuedResult<QList<long long>>
+sendTaskAddArray(const QueuedProcess::QueuedProcessDefinitions &_definitions,
+                 const long long _count, const QString &_token);
 /**
  * @brief send TaskEdit
  * @param _id
@@ -186,6 +228,20 @@ QueuedResult<bool> sendUserPermissionAdd(const long long _id,
 QueuedResult<bool> sendUserPermissionRemove(const long long _id,
                                             const QueuedEnums::Permission _permission,
                                             const QString &_token);
+/**
+ * @brief send UserQuotaEdit
+ * @param _id
+ * user ID
+ * @param _maxTasks
+ * maximal count of running tasks or -1
+ * @param _quota
+ * quota by CPU and memory, negative values are not changed
+ * @param _token
+ * auth user token
+ * @return true on successful quota edition
+ */
+QueuedResult<bool> sendUserQuotaEdit(const long long _id, const long long _maxTasks,
+                                     const QueuedLimits::Limits &_quota, const QString &_token);
 // specific methods for properties
 /**
  * @brief get plugin
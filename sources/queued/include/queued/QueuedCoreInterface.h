@@ -98,6 +98,36 @@ public slots:
      * @return  true on successful plugin removal
      */
     QDBusVariant PluginRemove(const QString &plugin, const QString &token);
+    /**
+     * @brief add resources reservation
+     * @param user
+     * user ID, 0 for maintenance window
+     * @param cpu
+     * reserved CPU cores, 0 for all cores
+     * @param memory
+     * reserved memory, 0 for all memory
+     * @param start
+     * start of the first window in ISO format
+     * @param end
+     * end of the first window in ISO format
+     * @param period
+     * window repeat period in seconds, 0 for single window
+     * @param token
+     * auth user token
+     * @return reservation ID or -1 if no reservation added
+     */
+    QDBusVariant ReservationAdd(const qlonglong user, const qlonglong cpu, const qlonglong memory,
+                                const QString &start, const QString &end, const qlonglong period,
+                                const QString &token);
+    /**
+     * @brief remove resources reservation
+     * @param id
+     * reservation ID
+     * @param token
+     * auth user token
+     * @return true on successful reservation removal
+     */
+    QDBusVariant ReservationRemove(const qlonglong id, const QString &token);
     /**
      * @brief add new task
      * @param command
@@ -120,6 +150,16 @@ public slots:
      * limit by GPU memory
      * @param storage
      * limit by storage
+     * @param walltime
+     * estimated run time in seconds
+     * @param gang
+     * count of cooperating processes which require dedicated CPU cores, 0 to disable
+     * @param startAfter
+     * time before which task may not be started in ISO format or empty
+     * @param deadline
+     * time by which task should be finished in ISO format or empty
+     * @param dependencies
+     * task dependencies in type:task format
      * @param token
      * auth user token
      * @return task ID or -1 if no task added
@@ -127,7 +167,56 @@ public slots:
     QDBusVariant TaskAdd(const QString &command, const QStringList &arguments,
                          const QString &workingDirectory, const qlonglong user, const uint nice,
                          const qlonglong cpu, const qlonglong gpu, const qlonglong memory,
-                         const qlonglong gpumemory, const qlonglong storage, const QString &token);
+                         const qlonglong gpumemory, const qlonglong storage,
+                         const qlonglong walltime, const uint gang, const QString &startAfter,
+                         const QString &deadline, const QStringList &dependencies,
+                         const QString &token);
+    /**
+     * @brief add new array task
+     * @param command
+     * command line
+     * @param arguments
+     * command line arguments
+     * @param workingDirectory
+     * working directory
+     * @param user
+     * user ID
+     * @param nice
+     * nice level
+     * @param cpu
+     * limit by CPU cores
+     * @param gpu
+     * limit by GPU cores
+     * @param memory
+     * limit by memory
+     * @param gpumemory
+     * limit by GPU memory
+     * @param storage
+     * limit by storage
+     * @param walltime
+     * estimated run time in seconds
+     * @param gang
+     * count of cooperating processes which require dedicated CPU cores, 0 to disable
+     * @param startAfter
+     * time before which task may not be started in ISO format or empty
+     * @param deadline
+     * time by which task should be finished in ISO format or empty
+     * @param dependencies
+     * task dependencies in type:task format
+     * @param count
+     * number of tasks in array
+     * @param token
+     * auth user token
+     * @return list of task IDs
+     */
+    QDBusVariant TaskAddArray(const QString &command, const QStringList &arguments,
+                              const QString &workingDirectory, const qlonglong user,
+                              const uint nice, const qlonglong cpu, const qlonglong gpu,
+                              const qlonglong memory, const qlonglong gpumemory,
+                              const qlonglong storage, const qlonglong walltime,
+                              const uint gang, const QString &startAfter,
+                              const QString &deadline, const QStringList &dependencies,
+                              const qlonglong count, const QString &token);
     /**
      * @brief edit task
      * @param id
@@ -156,6 +245,8 @@ public slots:
      * new limit by GPU memory or -1
      * @param storage
      * new limit by storage or -1
+     * @param walltime
+     * new estimated run time in seconds or -1
      * @param token
      * auth user token
      * @return true on successful task edition
@@ -164,7 +255,8 @@ public slots:
                           const QString &directory, const uint nice, const uint uid, const uint gid,
                           const qlonglong user, const qlonglong cpu, const qlonglong gpu,
                           const qlonglong memory, const qlonglong gpumemory,
-                          const qlonglong storage, const QString &token);
+                          const qlonglong storage, const qlonglong walltime,
+                          const QString &token);
     /**
      * @brief force start task
      * @param id
@@ -271,6 +363,22 @@ public slots:
      */
     QDBusVariant UserPermissionRemove(const qlonglong id, const uint permission,
                                       const QString &token);
+    /**
+     * @brief edit user quota
+     * @param id
+     * user ID
+     * @param maxTasks
+     * new maximal count of running tasks or -1
+     * @param cpu
+     * new quota by CPU cores or -1
+     * @param memory
+     * new quota by memory or -1
+     * @param token
+     * auth user token
+     * @return true on successful quota edition
+     */
+    QDBusVariant UserQuotaEdit(const qlonglong id, const qlonglong maxTasks, const qlonglong cpu,
+                               const qlonglong memory, const QString &token);
 
 private:
     /**
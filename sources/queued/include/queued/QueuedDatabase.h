@@ -143,6 +143,25 @@ public slots:
      * @return index of inserted record or -1 if no insertion
      */
     long long add(const QString &_table, const QVariantHash &_value);
+    /**
+     * @brief add records to database in single transaction
+     * @param _table
+     * table name
+     * @param _values
+     * values to insert
+     * @return indices of inserted records or empty list if no insertion
+     */
+    QList<long long> add(const QString &_table, const QList<QVariantHash> &_values);
+    /**
+     * @brief add tasks and their dependencies to database in single transaction
+     * @param _tasks
+     * tasks to insert
+     * @param _dependencies
+     * dependencies which are common for all tasks, task field is set on insertion
+     * @return indices of inserted tasks or empty list if no insertion
+     */
+    QList<long long> addTasks(const QList<QVariantHash> &_tasks,
+                              const QList<QVariantHash> &_dependencies);
     /**
      * @brief modify record in table
      * @param _table
@@ -196,6 +215,15 @@ private:
      * @return list of columns in table
      */
     QStringList getColumnsInRecord(const QSqlRecord &_record) const;
+    /**
+     * @brief insert records to table inside already started transaction
+     * @param _table
+     * table name
+     * @param _values
+     * values to insert
+     * @return indices of inserted records or empty list if any insertion has failed
+     */
+    QList<long long> insert(const QString &_table, const QList<QVariantHash> &_values);
     /**
      * @brief last insertion ID
      * @param _table
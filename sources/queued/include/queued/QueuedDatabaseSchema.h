@@ -34,10 +34,18 @@
  */
 namespace QueuedDB
 {
+/**
+ * @brief reservations table name
+ */
+static const char RESERVATIONS_TABLE[] = "reservations";
 /**
  * @brief settings table name
  */
 static const char SETTINGS_TABLE[] = "settings";
+/**
+ * @brief tasks dependencies table name
+ */
+static const char TASKS_DEPS_TABLE[] = "tasks_dependencies";
 /**
  * @brief tasks modifications table name
  */
@@ -81,10 +89,22 @@ typedef QHash<QString, QHash<QString, QueuedDBField>> QueuedDBSchema;
  * @brief database schema
  */
 static const QueuedDBSchema DBSchema
-    = {{SETTINGS_TABLE,
+    = {{RESERVATIONS_TABLE,
+        {{"_id", {"_id", "INT PRIMARY KEY AUTOINCREMENT UNIQUE", QVariant::LongLong, true}},
+         {"user", {"user", "INT NOT NULL DEFAULT 0", QVariant::LongLong, true}},
+         {"limits", {"limits", "TEXT", QVariant::String, true}},
+         {"startTime", {"startTime", "TEXT", QVariant::String, true}},
+         {"endTime", {"endTime", "TEXT", QVariant::String, true}},
+         {"period", {"period", "INT NOT NULL DEFAULT 0", QVariant::LongLong, true}}}},
+       {SETTINGS_TABLE,
         {{"_id", {"_id", "INT PRIMARY KEY AUTOINCREMENT UNIQUE", QVariant::LongLong, true}},
          {"key", {"key", "TEXT NOT NULL DEFAULT '0'", QVariant::String, true}},
          {"value", {"value", "TEXT", QVariant::String, true}}}},
+       {TASKS_DEPS_TABLE,
+        {{"_id", {"_id", "INT PRIMARY KEY AUTOINCREMENT UNIQUE", QVariant::LongLong, true}},
+         {"task", {"task", "INT NOT NULL DEFAULT 0", QVariant::LongLong, true}},
+         {"dependency", {"dependency", "INT NOT NULL DEFAULT 0", QVariant::LongLong, true}},
+         {"type", {"type", "INT NOT NULL DEFAULT 0", QVariant::Int, true}}}},
        {TASKS_MODS_TABLE,
         {{"_id", {"_id", "INT PRIMARY KEY AUTOINCREMENT UNIQUE", QVariant::LongLong, true}},
          {"task", {"task", "INT NOT NULL DEFAULT 0", QVariant::LongLong, true}},
@@ -101,8 +121,17 @@ static const QueuedDBSchema DBSchema
          {"uid", {"uid", "INT", QVariant::UInt, true}},
          {"gid", {"gid", "INT", QVariant::UInt, true}},
          {"limits", {"limits", "TEXT", QVariant::String, false}},
+         {"walltime", {"walltime", "INT NOT NULL DEFAULT 0", QVariant::LongLong, false}},
+         {"gang", {"gang", "INT NOT NULL DEFAULT 0", QVariant::UInt, false}},
+         {"startAfter", {"startAfter", "TEXT", QVariant::String, false}},
+         {"deadline", {"deadline", "TEXT", QVariant::String, false}},
          {"startTime", {"startTime", "TEXT", QVariant::String, true}},
-         {"endTime", {"endTime", "TEXT", QVariant::String, true}}}},
+         {"endTime", {"endTime", "TEXT", QVariant::String, true}},
+         {"exitCode", {"exitCode", "INT", QVariant::Int, true}},
+         {"exitReason", {"exitReason", "INT", QVariant::Int, true}},
+         {"cpuTime", {"cpuTime", "INT", QVariant::LongLong, true}},
+         {"memoryPeak", {"memoryPeak", "INT", QVariant::LongLong, true}},
+         {"ioBytes", {"ioBytes", "INT", QVariant::LongLong, true}}}},
        {TOKENS_TABLE,
         {{"_id", {"_id", "INT PRIMARY KEY AUTOINCREMENT UNIQUE", QVariant::LongLong, true}},
          {"token", {"token", "TEXT NOT NULL DEFAULT '0'", QVariant::String, true}},
@@ -115,6 +144,8 @@ static const QueuedDBSchema DBSchema
          {"email", {"email", "TEXT", QVariant::String, false}},
          {"lastLogin", {"lastLogin", "TEXT", QVariant::String, true}},
          {"limits", {"limits", "TEXT", QVariant::String, true}},
+         {"maxTasks", {"maxTasks", "INT NOT NULL DEFAULT 0", QVariant::LongLong, true}},
+         {"quota", {"quota", "TEXT", QVariant::String, true}},
          {"permissions", {"permissions", "INT", QVariant::UInt, true}},
          {"priotiry", {"priority", "INT", QVariant::UInt, true}}}}};
 }; // namespace QueuedDB
@@ -48,6 +48,10 @@ Q_DECLARE_LOGGING_CATEGORY(LOG_LIB)
  * @brief plugin logging category
  */
 Q_DECLARE_LOGGING_CATEGORY(LOG_PL)
+/**
+ * @brief scheduler decisions logging category
+ */
+Q_DECLARE_LOGGING_CATEGORY(LOG_SCHED)
 /**
  * @brief server logging category
  */
@@ -74,6 +74,32 @@ inline Permission stringToPermission(const QString &_permission)
                ? PermissionMap.value(_permission.toLower())
                : Permission::Invalid;
 };
+/**
+ * @enum DependencyType
+ * @brief condition of task dependency
+ * @var DependencyType::Invalid
+ * unknown condition
+ * @var DependencyType::AfterOk
+ * task may start after dependency has finished successfully
+ * @var DependencyType::AfterAny
+ * task may start after dependency has finished with any status
+ */
+enum class DependencyType { Invalid, AfterOk, AfterAny };
+static const QHash<QString, DependencyType> DependencyTypeMap = {
+    {"afterok", DependencyType::AfterOk},
+    {"afterany", DependencyType::AfterAny},
+};
+/**
+ * @brief converts string to dependency type enum
+ * @param _type
+ * dependency type string
+ * @return related DependencyType value
+ */
+inline DependencyType stringToDependencyType(const QString &_type)
+{
+    return DependencyTypeMap.contains(_type.toLower()) ? DependencyTypeMap.value(_type.toLower())
+                                                       : DependencyType::Invalid;
+};
 /**
  * @enum ExitAction
  * @brief action with child process on destruction
@@ -83,6 +109,93 @@ inline Permission stringToPermission(const QString &_permission)
  * send SIGKILL on exit
  */
 enum class ExitAction { Terminate = 1 << 1, Kill = 1 << 2 };
+/**
+ * @enum ExitReason
+ * @brief reason of task end
+ * @var ExitReason::Exit
+ * task has exited by itself
+ * @var ExitReason::Crash
+ * task has been killed by signal
+ * @var ExitReason::Cancel
+ * task has been cancelled before start
+ * @var ExitReason::OutOfMemory
+ * task processes have been killed by OOM killer
+ */
+enum class ExitReason { Exit, Crash, Cancel, OutOfMemory };
+/**
+ * @enum PreemptionMode
+ * @brief action with running tasks of lower priority if task does not fit into free resources
+ * @var PreemptionMode::None
+ * tasks are never preempted
+ * @var PreemptionMode::Suspend
+ * tasks are stopped and continued later, their memory is not released
+ * @var PreemptionMode::Requeue
+ * tasks are terminated and put back to queue
+ */
+enum class PreemptionMode { None, Suspend, Requeue };
+static const QHash<QString, PreemptionMode> PreemptionModeMap = {
+    {"none", PreemptionMode::None},
+    {"suspend", PreemptionMode::Suspend},
+    {"requeue", PreemptionMode::Requeue},
+};
+/**
+ * @brief converts string to preemption mode enum
+ * @param _mode
+ * preemption mode string
+ * @return related PreemptionMode value
+ */
+inline PreemptionMode stringToPreemptionMode(const QString &_mode)
+{
+    return PreemptionModeMap.contains(_mode.toLower()) ? PreemptionModeMap.value(_mode.toLower())
+                                                       : PreemptionMode::None;
+};
+/**
+ * @enum SchedulerPolicy
+ * @brief policy which is used to select tasks to start
+ * @var SchedulerPolicy::Invalid
+ * unknown policy
+ * @var SchedulerPolicy::FIFO
+ * tasks are started in order of addition
+ * @var SchedulerPolicy::Priority
+ * tasks with higher nice level are started first
+ * @var SchedulerPolicy::FairShare
+ * tasks of users with lower resource usage are started first
+ * @var SchedulerPolicy::Backfill
+ * priority policy which allows tasks to start before the first one
+ * @var SchedulerPolicy::ShortestJobFirst
+ * tasks with lower walltime are started first
+ * @var SchedulerPolicy::Deadline
+ * tasks with lower deadline slack are started first
+ */
+enum class SchedulerPolicy {
+    Invalid,
+    FIFO,
+    Priority,
+    FairShare,
+    Backfill,
+    ShortestJobFirst,
+    Deadline
+};
+static const QHash<QString, SchedulerPolicy> SchedulerPolicyMap = {
+    {"fifo", SchedulerPolicy::FIFO},
+    {"priority", SchedulerPolicy::Priority},
+    {"fairshare", SchedulerPolicy::FairShare},
+    {"backfill", SchedulerPolicy::Backfill},
+    {"sjf", SchedulerPolicy::ShortestJobFirst},
+    {"deadline", SchedulerPolicy::Deadline},
+};
+/**
+ * @brief converts string to scheduler policy enum
+ * @param _policy
+ * policy string
+ * @return related SchedulerPolicy value
+ */
+inline SchedulerPolicy stringToSchedulerPolicy(const QString &_policy)
+{
+    return SchedulerPolicyMap.contains(_policy.toLower())
+               ? SchedulerPolicyMap.value(_policy.toLower())
+               : SchedulerPolicy::Invalid;
+};
 /**
  * @enum ReturnStatus
  * @brief DBus response status
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2017 Queued team
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ *
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+/**
+ * @file QueuedHistogram.h
+ * Header of Queued library
+ * @author Queued team
+ * @copyright MIT
+ * @bug https://github.com/arcan1s/queued/issues
+ */
+
+
+#ifndef QUEUEDHISTOGRAM_H
+#define QUEUEDHISTOGRAM_H
+
+#include <QHash>
+#include <QVector>
+
+
+/**
+ * @brief histogram of latencies with constant relative precision
+ * @remark values are grouped into buckets by power of two, each of which is split into
+ * SUB_BUCKETS linear ones, thus the error is below 1 / SUB_BUCKETS of value while memory usage
+ * does not depend on count of recorded values
+ */
+class QueuedHistogram
+{
+public:
+    /**
+     * @brief count of linear buckets inside power of two range
+     */
+    static const long long SUB_BUCKETS = 16;
+
+    /**
+     * @brief count of recorded values
+     * @return count of values
+     */
+    long long count() const;
+    /**
+     * @brief maximal recorded value
+     * @return maximal value or 0 if there are no values
+     */
+    long long max() const;
+    /**
+     * @brief mean of recorded values
+     * @return mean value or 0 if there are no values
+     */
+    double mean() const;
+    /**
+     * @brief minimal recorded value
+     * @return minimal value or 0 if there are no values
+     */
+    long long min() const;
+    /**
+     * @brief value at percentile
+     * @param _percentile
+     * percentile in range (0, 100]
+     * @return the highest value of bucket in which percentile is found, but not more than maximal
+     * value
+     */
+    long long percentile(const double _percentile) const;
+    /**
+     * @brief record value
+     * @param _value
+     * value to record, negative values are recorded as 0
+     */
+    void record(const long long _value);
+    /**
+     * @brief histogram summary
+     * @return count, minimal, mean, maximal values and percentiles as strings
+     */
+    QHash<QString, QString> summary() const;
+
+private:
+    /**
+     * @brief counts of values in buckets
+     */
+    QVector<long long> m_buckets;
+    /**
+     * @brief count of recorded values
+     */
+    long long m_count = 0;
+    /**
+     * @brief maximal recorded value
+     */
+    long long m_max = 0;
+    /**
+     * @brief minimal recorded value
+     */
+    long long m_min = 0;
+    /**
+     * @brief sum of recorded values
+     */
+    double m_sum = 0.0;
+    /**
+     * @brief find bucket of value
+     * @param _value
+     * non-negative value
+     * @return bucket index
+     */
+    static int bucket(const long long _value);
+    /**
+     * @brief the highest value of bucket
+     * @param _bucket
+     * bucket index
+     * @return the highest value which belongs to bucket
+     */
+    static long long bucketMax(const int _bucket);
+};
+
+
+#endif /* QUEUEDHISTOGRAM_H */
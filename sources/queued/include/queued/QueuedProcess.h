@@ -28,12 +28,12 @@
 #include <QProcess>
 #include <QVariant>
 
+#include "QueuedEnums.h"
+#include "QueuedLimits.h"
+#include "QueuedUsageHistory.h"
+
 
 class QueuedControlGroupsAdaptor;
-namespace QueuedLimits
-{
-struct Limits;
-};
 
 /**
  * @brief implementation over QProcess to run processes
@@ -42,18 +42,28 @@ class QueuedProcess : public QProcess
 {
     Q_OBJECT
     Q_PROPERTY(QList<Q_PID> childrenPids READ childrenPids)
+    Q_PROPERTY(long long cpuTime READ cpuTime)
     Q_PROPERTY(long long index READ index)
+    Q_PROPERTY(long long ioBytes READ ioBytes)
+    Q_PROPERTY(long long memoryPeak READ memoryPeak)
     Q_PROPERTY(QString name READ name)
+    Q_PROPERTY(long long oomKills READ oomKills)
+    Q_PROPERTY(QString usage READ usage)
+    Q_PROPERTY(QStringList usageHistory READ usageHistory)
     // mutable properties
+    Q_PROPERTY(QDateTime deadline READ deadline WRITE setDeadline)
     Q_PROPERTY(QDateTime endTime READ endTime WRITE setEndTime)
+    Q_PROPERTY(uint gang READ gang WRITE setGang)
     Q_PROPERTY(uint gid READ uid WRITE setGid)
     Q_PROPERTY(QString limits READ limits WRITE setLimits)
     Q_PROPERTY(QString logError READ logError WRITE setLogError)
     Q_PROPERTY(QString logOutput READ logOutput WRITE setLogOutput)
     Q_PROPERTY(uint nice READ nice WRITE setNice)
+    Q_PROPERTY(QDateTime startAfter READ startAfter WRITE setStartAfter)
     Q_PROPERTY(QDateTime startTime READ startTime WRITE setStartTime)
     Q_PROPERTY(uint uid READ uid WRITE setUid)
     Q_PROPERTY(long long user READ user WRITE setUser)
+    Q_PROPERTY(long long walltime READ walltime WRITE setWalltime)
     Q_PROPERTY(QString workDirectory READ workDirectory WRITE setWorkDirectory)
 
 public:
@@ -78,6 +88,43 @@ public:
         QDateTime time;
         long long user = 0;
     };
+    /**
+     * @struct QueuedProcessDependency
+     * @brief structure to define task dependency
+     * @var QueuedProcessDependency::task
+     * ID of task which should be finished first
+     * @var QueuedProcessDependency::type
+     * dependency condition
+     */
+    struct QueuedProcessDependency {
+        long long task = 0;
+        QueuedEnums::DependencyType type = QueuedEnums::DependencyType::AfterOk;
+        // structure methods
+        /**
+         * @brief dependency to string conversion
+         * @return string representation of dependency in type:task format
+         */
+        QString toString() const
+        {
+            return QString("%1:%2").arg(QueuedEnums::DependencyTypeMap.key(type)).arg(task);
+        };
+        /**
+         * @brief default structure constructor
+         */
+        QueuedProcessDependency() = default;
+        /**
+         * @brief structure constructor from string representation
+         * @param _dependency
+         * dependency string representation, type might be omitted
+         */
+        explicit QueuedProcessDependency(const QString &_dependency)
+        {
+            auto fields = _dependency.split(':');
+            task = fields.last().toLongLong();
+            if (fields.count() > 1)
+                type = QueuedEnums::stringToDependencyType(fields.first());
+        };
+    };
     /**
      * @struct QueuedProcessDefinition
      * @brief structure to define process
@@ -101,6 +148,16 @@ public:
      * task owner ID
      * @var QueuedProcessDefinitions::limits
      * task limits
+     * @var QueuedProcessDefinitions::walltime
+     * estimated task run time in seconds, 0 if unknown
+     * @var QueuedProcessDefinitions::gang
+     * count of cooperating processes which require dedicated CPU cores, 0 if disabled
+     * @var QueuedProcessDefinitions::startAfter
+     * time before which task may not be started, invalid if task may start any time
+     * @var QueuedProcessDefinitions::deadline
+     * time by which task should be finished, invalid if there is no deadline
+     * @var QueuedProcessDefinitions::dependencies
+     * tasks which should be finished before start
      */
     struct QueuedProcessDefinitions {
         QString command;
@@ -113,6 +170,11 @@ public:
         QDateTime endTime;
         long long user = 0;
         QString limits;
+        long long walltime = 0;
+        uint gang = 0;
+        QDateTime startAfter;
+        QDateTime deadline;
+        QList<QueuedProcessDependency> dependencies;
         QList<QueuedProcessModDefinitions> modifications;
     };
 
@@ -135,28 +197,105 @@ public:
      * @brief force kill ald children
      */
     void killChildren();
+    /**
+     * @brief configure control group and start process in it
+     * @remark group is prepared by parent, forked child only writes to already opened files
+     */
+    void launch();
+    /**
+     * @brief continue process and its children after suspension
+     */
+    void resume();
+    /**
+     * @brief read resources used by process group and store them in history
+     * @param _time
+     * sample time
+     * @remark CPU and IO rates are calculated from the second sample. Counters are never
+     * decreased, thus they keep the last known values if group has been already released
+     */
+    void sampleUsage(const QDateTime &_time);
+    /**
+     * @brief stop process and its children
+     * @remark stopped processes keep their memory
+     */
+    void suspend();
     // properties
     /**
      * @brief children processes
      * @return list of pids of children processes
      */
     QList<Q_PID> childrenPids() const;
+    /**
+     * @brief control group of process
+     * @return pointer to control group adaptor
+     */
+    QueuedControlGroupsAdaptor *cgroup() const;
+    /**
+     * @brief consumed CPU time
+     * @return CPU time consumed by process group at the last sample in milliseconds
+     */
+    long long cpuTime() const;
+    /**
+     * @brief process definitions
+     * @return current definitions of process
+     */
+    const QueuedProcessDefinitions &definitions() const;
     /**
      * @brief index of process
      * @return assigned index of process
      */
     long long index() const;
+    /**
+     * @brief IO usage
+     * @return bytes read and written by process group at the last sample
+     */
+    long long ioBytes() const;
+    /**
+     * @brief memory peak
+     * @return the highest memory usage of process group at the last sample in bytes
+     */
+    long long memoryPeak() const;
     /**
      * @brief name of process
      * @return generated name of process
      */
     QString name() const;
+    /**
+     * @brief used resources
+     * @return the last usage sample in native format
+     */
+    QueuedUsageHistory::QueuedUsagePoint nativeUsage() const;
+    /**
+     * @brief OOM kills
+     * @return count of group processes killed by OOM killer at the last sample
+     */
+    long long oomKills() const;
+    /**
+     * @brief used resources
+     * @return the last usage sample as string or empty string if there are no samples
+     */
+    QString usage() const;
+    /**
+     * @brief used resources history
+     * @return usage samples as strings from the oldest to the newest
+     */
+    QStringList usageHistory() const;
     // mutable properties
+    /**
+     * @brief task deadline
+     * @return time by which task should be finished
+     */
+    QDateTime deadline() const;
     /**
      * @brief process end time
      * @return process end time
      */
     QDateTime endTime() const;
+    /**
+     * @brief gang size
+     * @return count of dedicated CPU cores, 0 if task is not gang one
+     */
+    uint gang() const;
     /**
      * @brief process GID
      * @return process GID
@@ -187,6 +326,11 @@ public:
      * @return process nice
      */
     uint nice() const;
+    /**
+     * @brief earliest start time
+     * @return time before which task may not be started
+     */
+    QDateTime startAfter() const;
     /**
      * @brief process start time
      * @return process start time
@@ -202,11 +346,22 @@ public:
      * @return process owner ID
      */
     long long user() const;
+    /**
+     * @brief estimated run time
+     * @return estimated process run time in seconds or 0 if unknown
+     */
+    long long walltime() const;
     /**
      * @brief working directory
      * @return process working directory
      */
     QString workDirectory() const;
+    /**
+     * @brief set task deadline
+     * @param _time
+     * time by which task should be finished
+     */
+    void setDeadline(const QDateTime &_time);
     /**
      * @brief set end time
      * @param _time
@@ -239,6 +394,12 @@ public:
      * new process nice
      */
     void setNice(const uint _nice);
+    /**
+     * @brief set earliest start time
+     * @param _time
+     * time before which task may not be started
+     */
+    void setStartAfter(const QDateTime &_time);
     /**
      * @brief set start time
      * @param _time
@@ -257,6 +418,39 @@ public:
      * new user ID
      */
     void setUser(const long long _user);
+    /**
+     * @brief replace control group by already created one
+     * @param _cgroup
+     * pointer to created group, process takes its ownership
+     * @remark it must be called before process start
+     */
+    void setCGroup(QueuedControlGroupsAdaptor *_cgroup);
+    /**
+     * @brief set CPU cores
+     * @param _cpus
+     * list of CPU cores allowed for process, empty list means inherited cores
+     * @remark cores are applied to control group on start or immediately if process is running
+     */
+    void setCpuSet(const QList<long long> &_cpus);
+    /**
+     * @brief set gang size
+     * @param _gang
+     * new count of dedicated CPU cores
+     */
+    void setGang(const uint _gang);
+    /**
+     * @brief set memory nodes
+     * @param _nodes
+     * list of NUMA nodes allowed for process memory, empty list means inherited nodes
+     * @remark nodes are applied to control group on start or immediately if process is running
+     */
+    void setMemorySet(const QList<long long> &_nodes);
+    /**
+     * @brief set estimated run time
+     * @param _walltime
+     * new estimated process run time in seconds
+     */
+    void setWalltime(const long long _walltime);
     /**
      * @brief set working directory
      * @param _workDirectory
@@ -285,6 +479,50 @@ protected:
 
 private:
     QueuedControlGroupsAdaptor *m_cgroup = nullptr;
+    /**
+     * @brief control group exists already
+     */
+    bool m_groupCreated = false;
+    /**
+     * @brief process has joined control group before exec
+     */
+    bool m_groupJoined = false;
+    /**
+     * @brief opened process list files of control group which are used by child
+     */
+    QList<int> m_procFiles;
+    /**
+     * @brief consumed CPU time in nanoseconds at the last sample
+     */
+    long long m_cpuTime = 0;
+    /**
+     * @brief bytes read and written at the last sample
+     */
+    long long m_ioBytes = 0;
+    /**
+     * @brief the highest memory usage at the last sample
+     */
+    long long m_memoryPeak = 0;
+    /**
+     * @brief count of processes killed by OOM killer at the last sample
+     */
+    long long m_oomKills = 0;
+    /**
+     * @brief used resources history
+     */
+    QueuedUsageHistory m_usage;
+    /**
+     * @brief time of the last sample
+     */
+    QDateTime m_usageTime;
+    /**
+     * @brief CPU cores allowed for process
+     */
+    QList<long long> m_cpuSet;
+    /**
+     * @brief memory nodes allowed for process
+     */
+    QList<long long> m_memorySet;
     /**
      * @brief process definitions
      */
@@ -293,6 +531,10 @@ private:
      * @brief index of process
      */
     long long m_index = -1;
+    /**
+     * @brief process limits in native format
+     */
+    QueuedLimits::Limits m_nativeLimits;
 };
 
 
@@ -25,16 +25,26 @@
 #define QUEUEDPROCESSMANAGER_H
 
 #include <QDateTime>
+#include <QElapsedTimer>
+#include <QFileSystemWatcher>
 #include <QHash>
+#include <QMap>
 #include <QObject>
+#include <QSet>
+#include <QTimer>
 
+#include "QueuedHistogram.h"
 #include "QueuedProcess.h"
 
 
 class QueuedPluginManagerInterface;
+class QueuedSchedulerPolicy;
 namespace QueuedEnums
 {
 enum class ExitAction;
+enum class ExitReason;
+enum class PreemptionMode;
+enum class SchedulerPolicy;
 };
 
 /**
@@ -43,7 +53,17 @@ enum class ExitAction;
 class QueuedProcessManager : public QObject
 {
     Q_OBJECT
+    Q_PROPERTY(
+        long long admissionHysteresis READ admissionHysteresis WRITE setAdmissionHysteresis)
+    Q_PROPERTY(long long admissionInterval READ admissionInterval WRITE setAdmissionInterval)
+    Q_PROPERTY(long long admissionMargin READ admissionMargin WRITE setAdmissionMargin)
+    Q_PROPERTY(bool cpuPinning READ cpuPinning WRITE setCpuPinning)
+    Q_PROPERTY(long long fairShareHalfLife READ fairShareHalfLife WRITE setFairShareHalfLife)
+    Q_PROPERTY(long long groupPool READ groupPool WRITE setGroupPool)
     Q_PROPERTY(QueuedEnums::ExitAction onExit READ onExit WRITE setExitAction)
+    Q_PROPERTY(QueuedEnums::SchedulerPolicy policy READ policy WRITE setPolicy)
+    Q_PROPERTY(QueuedEnums::PreemptionMode preemption READ preemption WRITE setPreemption)
+    Q_PROPERTY(long long usageInterval READ usageInterval WRITE setUsageInterval)
 
 public:
     /**
@@ -53,9 +73,105 @@ public:
     typedef QHash<long long, QueuedProcess *> QueuedProcessMap;
     /**
      * @typedef QueuedProcessConnectionMap
-     * map of indices to related QMetaObject::Connection
+     * map of indices to related QMetaObject::Connection list
      */
-    typedef QHash<long long, QMetaObject::Connection> QueuedProcessConnectionMap;
+    typedef QHash<long long, QList<QMetaObject::Connection>> QueuedProcessConnectionMap;
+    /**
+     * @struct QueuedPendingKey
+     * @brief key of pending tasks queue
+     * @var QueuedPendingKey::rank
+     * task rank defined by scheduler policy
+     * @var QueuedPendingKey::index
+     * task index
+     * @var QueuedPendingKey::user
+     * task owner ID, it is not used for ordering
+     */
+    struct QueuedPendingKey {
+        long long rank = 0;
+        long long index = -1;
+        long long user = 0;
+        /**
+         * @brief less operator implementation
+         * @param _other
+         * other key
+         * @return true if this task should be started before other one
+         */
+        bool operator<(const QueuedPendingKey &_other) const
+        {
+            // lower rank goes first, then older task
+            return (rank < _other.rank) || ((rank == _other.rank) && (index < _other.index));
+        };
+    };
+    /**
+     * @typedef QueuedPendingQueue
+     * ordered map of pending task keys to task indices
+     */
+    typedef QMap<QueuedPendingKey, long long> QueuedPendingQueue;
+    /**
+     * @typedef QueuedUserQueueMap
+     * map of user IDs to their pending queues
+     */
+    typedef QHash<long long, QueuedPendingQueue> QueuedUserQueueMap;
+    /**
+     * @struct QueuedReservation
+     * @brief resources reserved by running task
+     * @var QueuedReservation::user
+     * task owner ID
+     * @var QueuedReservation::limits
+     * reserved resources
+     */
+    struct QueuedReservation {
+        long long user = 0;
+        QueuedLimits::Limits limits;
+    };
+    /**
+     * @struct QueuedUserQuota
+     * @brief running tasks of user
+     * @var QueuedUserQuota::tasks
+     * count of running tasks
+     * @var QueuedUserQuota::limits
+     * resources reserved by running tasks
+     */
+    struct QueuedUserQuota {
+        long long tasks = 0;
+        QueuedLimits::Limits limits;
+    };
+    /**
+     * @struct QueuedPendingTask
+     * @brief descriptor of task which has not been started yet
+     * @var QueuedPendingTask::definitions
+     * task definitions
+     * @var QueuedPendingTask::limits
+     * task limits converted from definitions
+     * @var QueuedPendingTask::queued
+     * time since task has been put to pending list
+     */
+    struct QueuedPendingTask {
+        QueuedProcess::QueuedProcessDefinitions definitions;
+        QueuedLimits::Limits limits;
+        QElapsedTimer queued;
+    };
+    /**
+     * @struct QueuedCapacityReservation
+     * @brief resources which are reserved for user during time window
+     * @var QueuedCapacityReservation::user
+     * user ID who may use reserved resources, 0 means that nobody may use them
+     * @var QueuedCapacityReservation::limits
+     * reserved CPU cores and memory, zero values mean the whole machine
+     * @var QueuedCapacityReservation::startTime
+     * start of the first window
+     * @var QueuedCapacityReservation::endTime
+     * end of the first window
+     * @var QueuedCapacityReservation::period
+     * window repeat period in seconds, 0 if window is not repeated
+     */
+    struct QueuedCapacityReservation {
+        long long user = 0;
+        QueuedLimits::Limits limits;
+        QDateTime startTime;
+        QDateTime endTime;
+        long long period = 0;
+    };
 
     /**
      * @brief QueuedProcessManager class constructor
@@ -73,10 +189,42 @@ public:
      * map of task properties
      * @param _modifications
      * list of task modifications
+     * @param _dependencies
+     * list of task dependencies
      * @return data mapped to internal format
      */
     static QueuedProcess::QueuedProcessDefinitions
-    parseDefinitions(const QVariantHash &_properties, const QList<QVariantHash> &_modifications);
+    parseDefinitions(const QVariantHash &_properties, const QList<QVariantHash> &_modifications,
+                     const QList<QVariantHash> &_dependencies = QList<QVariantHash>());
+    /**
+     * @brief parse reservation from table data
+     * @param _properties
+     * map of reservation properties
+     * @return reservation mapped to internal format
+     */
+    static QueuedCapacityReservation parseReservation(const QVariantHash &_properties);
+    /**
+     * @brief add or replace reservation
+     * @param _id
+     * reservation ID
+     * @param _reservation
+     * reservation description
+     * @remark resources are not available for tasks of other users during window. Task may start
+     * before window only if its walltime ends before window starts, tasks without walltime are
+     * expected to run forever
+     */
+    void addReservation(const long long _id, const QueuedCapacityReservation &_reservation);
+    /**
+     * @brief add resources consumed by user
+     * @param _user
+     * user ID
+     * @param _usage
+     * consumed resources multiplied by time in seconds
+     * @param _time
+     * time when resources have been consumed
+     */
+    void addUsage(const long long _user, const QueuedLimits::Limits &_usage,
+                  const QDateTime &_time);
     /**
      * @brief add task
      * @param _properties
@@ -85,30 +233,59 @@ public:
      * list of task modifications
      * @param _index
      * task index
-     * @return pointer to created task
+     * @param _dependencies
+     * list of task dependencies from database
      */
-    QueuedProcess *add(const QVariantHash &_properties, const QList<QVariantHash> &_modifications,
-                       const long long _index);
+    void add(const QVariantHash &_properties, const QList<QVariantHash> &_modifications,
+             const long long _index,
+             const QList<QVariantHash> &_dependencies = QList<QVariantHash>());
     /**
      * @brief add task
      * @param _definitions
      * process definitions
      * @param _index
      * task index
-     * @return pointer to created task
+     * @remark task is not queued until all dependencies which are still active have finished.
+     * Process object is created on task start only
+     */
+    void add(const QueuedProcess::QueuedProcessDefinitions &_definitions, const long long _index);
+    /**
+     * @brief add tasks
+     * @param _definitions
+     * process definitions mapped by task index
+     * @remark unlike single task addition, tasks are scheduled once after all of them have been
+     * added
+     */
+    void add(const QMap<long long, QueuedProcess::QueuedProcessDefinitions> &_definitions);
+    /**
+     * @brief is task active
+     * @param _index
+     * task index
+     * @return true if task is either pending or running
      */
-    QueuedProcess *add(const QueuedProcess::QueuedProcessDefinitions &_definitions,
-                       const long long _index);
+    bool contains(const long long _index) const;
     /**
-     * @brief task
+     * @brief pending queue
+     * @return tasks which are waiting for start in policy order
+     */
+    const QueuedPendingQueue &pendingQueue() const;
+    /**
+     * @brief task which has not been started yet
+     * @param _index
+     * task index
+     * @return pointer to task descriptor or nullptr if there is no such pending task
+     */
+    const QueuedPendingTask *pendingTask(const long long _index) const;
+    /**
+     * @brief running task
      * @param _index
      * task index
      * @return task found by index or nullptr
      */
     QueuedProcess *process(const long long _index);
     /**
-     * @brief all tasks
-     * @return list of all tasks
+     * @brief running tasks
+     * @return list of running tasks
      */
     QueuedProcessMap processes();
     /**
@@ -118,7 +295,41 @@ public:
      */
     void remove(const long long _index);
     /**
-     * @brief select and start task automatically
+     * @brief remove reservation
+     * @param _id
+     * reservation ID
+     */
+    void removeReservation(const long long _id);
+    /**
+     * @brief set user quota
+     * @param _user
+     * user ID
+     * @param _tasks
+     * maximal count of running tasks, 0 means unlimited
+     * @param _limits
+     * maximal CPU and memory reserved by running tasks, zero values mean unlimited
+     * @remark task which does not fit into user quota is skipped in scheduling pass, thus task
+     * which requires more resources than quota is never started automatically
+     */
+    void setQuota(const long long _user, const long long _tasks,
+                  const QueuedLimits::Limits &_limits);
+    /**
+     * @brief update pending task after its properties have been changed
+     * @param _index
+     * task index
+     * @param _definitions
+     * new task definitions
+     */
+    void update(const long long _index,
+                const QueuedProcess::QueuedProcessDefinitions &_definitions);
+    /**
+     * @brief select and start tasks automatically
+     * @remark tasks are started in queue order until the next one does not fit into free
+     * resources, start times are emitted once all of them have been launched. If policy allows
+     * backfill, other tasks may be started after that as long as they do not delay the first one.
+     * Backfill is not used with usage based admission. If preemption is enabled, running tasks with
+     * lower nice level may be suspended or requeued to start the first task, suspended tasks are
+     * continued once they fit into free resources again
      */
     void start();
     /**
@@ -127,29 +338,157 @@ public:
      * task index
      */
     void start(const long long _index);
+    /**
+     * @brief scheduler latency statistics
+     * @return summaries of scheduling pass duration, time between task addition and start and
+     * time between start and process execution in microseconds mapped by section name
+     */
+    QHash<QString, QHash<QString, QString>> statistics() const;
     /**
      * @brief force stop task
      * @param _index
      * task index
+     * @remark pending task is cancelled
      */
     void stop(const long long _index);
+    /**
+     * @brief user fair share usage
+     * @param _user
+     * user ID
+     * @return decayed usage in machine seconds including running tasks
+     */
+    double usage(const long long _user) const;
+    /**
+     * @brief pending queues of each user
+     * @return map of user IDs to their pending queues
+     */
+    const QueuedUserQueueMap &userQueues() const;
     // properties
+    /**
+     * @brief usage based admission hysteresis
+     * @return percentage of resources which should be released after overload before new tasks
+     * are admitted
+     */
+    long long admissionHysteresis() const;
+    /**
+     * @brief usage based admission interval
+     * @return the longest interval between resource usage samples in milliseconds, 0 if tasks are
+     * admitted by declared limits
+     */
+    long long admissionInterval() const;
+    /**
+     * @brief usage based admission margin
+     * @return percentage of resources which are kept free
+     */
+    long long admissionMargin() const;
+    /**
+     * @brief CPU pinning
+     * @return true if every task gets dedicated CPU cores
+     */
+    bool cpuPinning() const;
+    /**
+     * @brief fair share usage half life
+     * @return period in seconds after which usage is decreased twice
+     */
+    long long fairShareHalfLife() const;
+    /**
+     * @brief control group pool size
+     * @return count of control groups which are created in advance
+     */
+    long long groupPool() const;
     /**
      * @brief default action on exit
      * @return default action from possible ones
      */
     QueuedEnums::ExitAction onExit() const;
+    /**
+     * @brief scheduler policy
+     * @return current scheduler policy type
+     */
+    QueuedEnums::SchedulerPolicy policy() const;
+    /**
+     * @brief preemption mode
+     * @return action with tasks of lower priority
+     */
+    QueuedEnums::PreemptionMode preemption() const;
+    /**
+     * @brief usage sampling interval
+     * @return the shortest interval between usage samples of running tasks in milliseconds
+     */
+    long long usageInterval() const;
+    /**
+     * @brief set usage based admission hysteresis
+     * @param _hysteresis
+     * new hysteresis in percents
+     */
+    void setAdmissionHysteresis(const long long _hysteresis);
+    /**
+     * @brief set usage based admission interval
+     * @param _interval
+     * the longest interval between usage samples in milliseconds, 0 to disable usage based
+     * admission
+     */
+    void setAdmissionInterval(const long long _interval);
+    /**
+     * @brief set usage based admission margin
+     * @param _margin
+     * new margin in percents
+     */
+    void setAdmissionMargin(const long long _margin);
+    /**
+     * @brief set CPU pinning
+     * @param _pinning
+     * true if every task should get dedicated CPU cores, it is applied to new tasks only
+     */
+    void setCpuPinning(const bool _pinning);
+    /**
+     * @brief set fair share usage half life
+     * @param _halfLife
+     * new half life in seconds
+     */
+    void setFairShareHalfLife(const long long _halfLife);
+    /**
+     * @brief set control group pool size
+     * @param _size
+     * new count of control groups which are created in advance, 0 to disable pool
+     */
+    void setGroupPool(const long long _size);
     /**
      * @brief set on exit action
      * @param _action
      * new on exit action
      */
     void setExitAction(const QueuedEnums::ExitAction _action);
+    /**
+     * @brief set scheduler policy
+     * @param _policy
+     * new scheduler policy, pending tasks will be reordered
+     */
+    void setPolicy(const QueuedEnums::SchedulerPolicy _policy);
+    /**
+     * @brief set preemption mode
+     * @param _mode
+     * new preemption mode, suspended tasks are continued if preemption is disabled
+     */
+    void setPreemption(const QueuedEnums::PreemptionMode _mode);
+    /**
+     * @brief set usage sampling interval
+     * @param _interval
+     * new interval in milliseconds, 0 to disable sampling
+     */
+    void setUsageInterval(const long long _interval);
     /**
      * @brief get used limits
      * @return used system limits
      */
-    QueuedLimits::Limits usedLimits();
+    QueuedLimits::Limits usedLimits() const;
+    /**
+     * @brief get resources which will be actually reserved by task
+     * @param _limits
+     * task defined limits
+     * @return limits in which empty values are replaced by system ones
+     */
+    static QueuedLimits::Limits requiredLimits(const QueuedLimits::Limits &_limits);
 
 signals:
     /**
@@ -160,6 +499,23 @@ signals:
      * task start time
      */
     void taskStartTimeReceived(const long long _index, const QDateTime &_time);
+    /**
+     * @brief signal which will be called on task end before stop time
+     * @param _index
+     * task index
+     * @param _exitCode
+     * task exit code, -1 if task has crashed or has been cancelled
+     * @param _reason
+     * reason of task end
+     */
+    void taskExitCodeReceived(const long long _index, const int _exitCode,
+                              const QueuedEnums::ExitReason _reason);
+    /**
+     * @brief signal which will be called if running task has been put back to queue
+     * @param _index
+     * task index
+     */
+    void taskRequeued(const long long _index);
     /**
      * @brief signal which will be called on task end
      * @param _index
@@ -168,10 +524,49 @@ signals:
      * task stop time
      */
     void taskStopTimeReceived(const long long _index, const QDateTime &_time);
+    /**
+     * @brief signal which will be called on task end or requeue with resources actually
+     * consumed by task run
+     * @param _index
+     * task index
+     * @param _cpuTime
+     * consumed CPU time in milliseconds
+     * @param _memoryPeak
+     * the highest memory usage in bytes
+     * @param _ioBytes
+     * bytes read and written
+     */
+    void taskUsageReceived(const long long _index, const long long _cpuTime,
+                           const long long _memoryPeak, const long long _ioBytes);
+
+protected:
+    /**
+     * @brief current time
+     * @return time which is used for all scheduling decisions
+     */
+    virtual QDateTime currentTime() const;
+    /**
+     * @brief start process after resources have been reserved
+     * @param _process
+     * pointer to process
+     * @remark process owner is notified about its end by QProcess::finished signal
+     */
+    virtual void startProcess(QueuedProcess *_process);
 
 private slots:
+    /**
+     * @brief finish task if its main process has exited and its group has become empty
+     * @remark objects of removed tasks are deleted here as well, their groups could not be
+     * removed until the last process has exited. Changes of memory events files are only logged
+     * if OOM killer has killed task processes
+     * @param _path
+     * full path to changed events or memory events file
+     */
+    void groupChanged(const QString &_path);
     /**
      * @brief slot for catching finished tasks
+     * @remark if group events are watched, task is finished only after all its processes have
+     * exited, because children may outlive the main process
      * @param _exitCode
      * exit code of finished task
      * @param _exitStatus
@@ -183,18 +578,392 @@ private slots:
                       const long long _index);
 
 private:
+    /**
+     * @brief new tasks are not admitted until usage drops below hysteresis threshold
+     */
+    bool m_admissionBlocked = false;
+    /**
+     * @brief usage based admission hysteresis in percents
+     */
+    long long m_admissionHysteresis = 5;
+    /**
+     * @brief the longest interval between usage samples in milliseconds
+     */
+    long long m_admissionInterval = 0;
+    /**
+     * @brief usage based admission margin in percents
+     */
+    long long m_admissionMargin = 10;
+    /**
+     * @brief watcher of group and memory events files of running tasks
+     */
+    QFileSystemWatcher m_events;
+    /**
+     * @brief tasks mapped by their watched events files
+     */
+    QHash<QString, long long> m_eventFiles;
+    /**
+     * @brief exit code and status of tasks whose main process has exited before their children
+     */
+    QHash<long long, QPair<int, QProcess::ExitStatus>> m_exited;
+    /**
+     * @brief tasks mapped by their watched memory events files
+     */
+    QHash<QString, long long> m_memoryEventFiles;
+    /**
+     * @brief the last known OOM kills count of running tasks
+     */
+    QHash<long long, long long> m_oomKills;
+    /**
+     * @brief removed tasks mapped by events files of their groups which still contain processes
+     */
+    QHash<QString, QueuedProcess *> m_orphans;
+    /**
+     * @brief every task gets dedicated CPU cores
+     */
+    bool m_cpuPinning = false;
+    /**
+     * @brief count of finished tasks which have met their deadlines
+     */
+    long long m_deadlinesMet = 0;
+    /**
+     * @brief count of finished tasks which have missed their deadlines
+     */
+    long long m_deadlinesMissed = 0;
+    /**
+     * @brief tasks which may not be started yet mapped by their earliest start time
+     */
+    QMultiMap<QDateTime, long long> m_delayed;
+    /**
+     * @brief time between process start and its execution in microseconds
+     */
+    QueuedHistogram m_dispatchLatency;
+    /**
+     * @brief time between task addition and its start in microseconds
+     */
+    QueuedHistogram m_queueWait;
+    /**
+     * @brief scheduling pass duration in microseconds
+     */
+    QueuedHistogram m_schedulingPass;
+    /**
+     * @brief control groups which have been created in advance
+     */
+    QList<QueuedControlGroupsAdaptor *> m_groups;
+    /**
+     * @brief last used index of pooled control group
+     */
+    long long m_groupIndex = 0;
+    /**
+     * @brief count of control groups which are created in advance
+     */
+    long long m_groupPool = 0;
     /**
      * @brief connection map
      */
     QueuedProcessConnectionMap m_connections;
+    /**
+     * @brief pending queue
+     */
+    QueuedPendingQueue m_queue;
+    /**
+     * @brief keys of tasks in pending queue
+     */
+    QHash<long long, QueuedPendingKey> m_queueKeys;
+    /**
+     * @brief fair share usage half life in seconds
+     */
+    long long m_halfLife = 604800;
+    /**
+     * @brief resources reserved by running tasks
+     */
+    QHash<long long, QueuedReservation> m_running;
+    /**
+     * @brief share of resources reserved by running tasks of each user
+     */
+    QHash<long long, double> m_runningShare;
+    /**
+     * @brief total resources reserved by running tasks
+     */
+    QueuedLimits::Limits m_used;
+    /**
+     * @brief decayed usage of each user in machine seconds
+     */
+    QHash<long long, double> m_usage;
+    /**
+     * @brief last time when usage has been decayed
+     */
+    QDateTime m_usageTime;
+    /**
+     * @brief pending queues of each user
+     */
+    QueuedUserQueueMap m_userQueues;
+    /**
+     * @brief quotas of users
+     */
+    QHash<long long, QueuedUserQuota> m_quotas;
+    /**
+     * @brief running tasks counters of each user
+     */
+    QHash<long long, QueuedUserQuota> m_userRunning;
+    /**
+     * @brief reservations of resources
+     */
+    QHash<long long, QueuedCapacityReservation> m_reservations;
+    /**
+     * @brief timer which is fired at the end of the nearest reservation window
+     */
+    QTimer m_reservationTimer;
+    /**
+     * @brief timer which is fired when the nearest delayed task may be started
+     */
+    QTimer m_wakeupTimer;
+    /**
+     * @brief the shortest interval between usage samples in milliseconds
+     */
+    long long m_usageInterval = 0;
+    /**
+     * @brief timer which samples usage of all running tasks
+     */
+    QTimer m_usageTimer;
+    /**
+     * @brief active dependencies of tasks which are not queued yet
+     */
+    QHash<long long, QSet<long long>> m_waiting;
+    /**
+     * @brief tasks which depend on task with conditions
+     */
+    QHash<long long, QHash<long long, QueuedEnums::DependencyType>> m_dependents;
     /**
      * @brief action on exit
      */
     QueuedEnums::ExitAction m_onExit;
     /**
-     * @brief processes list
+     * @brief scheduler policy
+     */
+    QueuedSchedulerPolicy *m_policy = nullptr;
+    /**
+     * @brief preemption mode
+     */
+    QueuedEnums::PreemptionMode m_preemption;
+    /**
+     * @brief running tasks which have been suspended, their CPU is not reserved
+     */
+    QSet<long long> m_suspended;
+    /**
+     * @brief tasks which have not been started yet
+     */
+    QHash<long long, QueuedPendingTask> m_pending;
+    /**
+     * @brief running processes list
      */
     QueuedProcessMap m_processes;
+    /**
+     * @brief CPU cores dedicated to running tasks
+     */
+    QHash<long long, QList<long long>> m_cores;
+    /**
+     * @brief dedicate CPU cores to task if it is gang one or pinning is enabled
+     * @param _index
+     * task index
+     * @remark cores are taken from the NUMA node with the least free cores which fits the whole
+     * task, otherwise from nodes with the most free cores. Memory is bound to the same nodes,
+     * other tasks are moved to the rest cores. Tasks without CPU limit run on shared cores
+     */
+    void allocateCores(const long long _index);
+    /**
+     * @brief start tasks which do not delay the first task in queue
+     * @remark tasks are started only if they fit into user quotas
+     * @param _time
+     * task start time
+     * @return list of started task indices
+     */
+    QList<long long> backfillTasks(const QDateTime &_time);
+    /**
+     * @brief finish task which will never be started
+     * @param _index
+     * task index
+     */
+    void cancel(const long long _index);
+    /**
+     * @brief put task to pending list without scheduling
+     * @param _definitions
+     * process definitions
+     * @param _index
+     * task index
+     */
+    void create(const QueuedProcess::QueuedProcessDefinitions &_definitions,
+                const long long _index);
+    /**
+     * @brief usage decay factor
+     * @param _from
+     * time when usage has been calculated
+     * @param _to
+     * current time
+     * @return multiplier for usage
+     */
+    double decay(const QDateTime &_from, const QDateTime &_to) const;
+    /**
+     * @brief remove task from pending queue
+     * @param _index
+     * task index
+     */
+    void dequeue(const long long _index);
+    /**
+     * @brief resources which may be used by new tasks
+     * @remark if usage based admission is enabled, free resources are calculated from the last
+     * usage samples of tasks minus margin, otherwise from reservations
+     * @return free CPU cores and memory, negative values mean that no task may be admitted
+     */
+    QueuedLimits::Limits freeLimits();
+    /**
+     * @brief put pending task to queue
+     * @param _index
+     * task index
+     */
+    void enqueue(const long long _index);
+    /**
+     * @brief create control groups until pool is full
+     */
+    void fillGroupPool();
+    /**
+     * @brief create process for pending task and start it without notification
+     * @param _index
+     * task index
+     * @param _time
+     * task start time
+     */
+    void launch(const long long _index, const QDateTime &_time);
+    /**
+     * @brief release resources reserved by task
+     * @param _index
+     * task index
+     */
+    void release(const long long _index);
+    /**
+     * @brief release tasks which depend on finished task
+     * @param _index
+     * finished task index
+     * @param _success
+     * true if task has finished successfully
+     */
+    void resolve(const long long _index, const bool _success);
+    /**
+     * @brief preempt running tasks with lower priority
+     * @param _index
+     * index of pending task which should be started
+     * @param _reserved
+     * resources reserved for other users which may not be used by task
+     * @remark victims with the lowest nice level and the latest start go first, nothing is
+     * preempted if task does not fit even after that
+     * @return true if task fits into free resources now
+     */
+    bool preempt(const long long _index, const QueuedLimits::Limits &_reserved);
+    /**
+     * @brief terminate running task and put it back to pending queue
+     * @param _index
+     * task index
+     */
+    void requeue(const long long _index);
+    /**
+     * @brief resources which may not be used by pending task because of reservations
+     * @param _index
+     * task index
+     * @remark resources of active windows which are already used by their owners are not counted
+     * @return CPU cores and memory reserved for other users during task run
+     */
+    QueuedLimits::Limits reservedLimits(const long long _index) const;
+    /**
+     * @brief continue suspended task
+     * @param _index
+     * task index
+     */
+    void resume(const long long _index);
+    /**
+     * @brief continue suspended tasks which fit into free resources
+     * @remark task is not continued if there is pending task with higher nice level
+     */
+    void resumeTasks();
+    /**
+     * @brief store resources used by running tasks, restart sampling timer and try to start new
+     * tasks if usage based admission is enabled
+     * @remark interval is doubled after each sample up to 16 shortest ones, but not above
+     * admission interval, and it is reset on task start, because long running tasks change their
+     * usage slowly
+     */
+    void sampleTasks();
+    /**
+     * @brief suspend running task and release its CPU
+     * @param _index
+     * task index
+     */
+    void suspend(const long long _index);
+    /**
+     * @brief limits of pending task
+     * @param _definitions
+     * task definitions
+     * @return limits converted from definitions, gang task requires a core per process
+     */
+    static QueuedLimits::Limits
+    taskLimits(const QueuedProcess::QueuedProcessDefinitions &_definitions);
+    /**
+     * @brief move tasks which are not gang ones to shared CPU cores
+     */
+    void updateCpuSets();
+    /**
+     * @brief restart reservation timer according to the nearest window end
+     */
+    void updateReservationTimer();
+    /**
+     * @brief share of machine resources
+     * @param _limits
+     * resources to calculate
+     * @return sum of CPU and memory proportions
+     */
+    static double share(const QueuedLimits::Limits &_limits);
+    /**
+     * @brief CPU cores which are not dedicated to gang tasks
+     * @return list of shared CPU cores
+     */
+    QList<long long> sharedCores() const;
+    /**
+     * @brief the shortest interval between usage samples
+     * @remark admission interval is used if usage interval is not set
+     * @return interval in milliseconds, 0 if usage is not sampled
+     */
+    long long shortestUsageInterval() const;
+    /**
+     * @brief decay stored usage to the specified time
+     * @param _time
+     * current time
+     */
+    void updateUsage(const QDateTime &_time);
+    /**
+     * @brief restart wakeup timer according to the nearest delayed task
+     */
+    void updateWakeupTimer();
+    /**
+     * @brief enqueue delayed tasks which may be started now
+     */
+    void wakeup();
+    /**
+     * @brief check if pending task fits into quota of its owner
+     * @param _index
+     * task index
+     * @return true if task may be started
+     */
+    bool withinQuota(const long long _index) const;
+    /**
+     * @brief start of the current or the next reservation window
+     * @param _reservation
+     * reservation description
+     * @param _time
+     * time to look window for
+     * @return start of the window which ends after specified time or invalid time if there is no
+     * such window
+     */
+    static QDateTime windowStart(const QueuedCapacityReservation &_reservation,
+                                 const QDateTime &_time);
 };
 
 
@@ -66,7 +66,7 @@ public slots:
     QDBusVariant Performance(const QString &from, const QString &to, const QString &token);
     /**
      * @brief server status
-     * @return server status
+     * @return server status including scheduler latency statistics
      */
     QDBusVariant Status();
     /**
@@ -28,6 +28,7 @@
 #include <QObject>
 
 #include "QueuedEnums.h"
+#include "QueuedLimits.h"
 
 
 class QueuedCore;
@@ -64,10 +65,27 @@ public:
      * stop report date
      * @param _core
      * pointer to core object
+     * @remark resources actually consumed by tasks are used if they have been recorded
      * @return performance table
      */
     QList<QVariantHash> performance(const QueuedCore *_core, const QDateTime &_from = QDateTime(),
                                     const QDateTime &_to = QDateTime()) const;
+    /**
+     * @brief resources actually consumed by task
+     * @param _task
+     * task in database format
+     * @return consumed CPU time in seconds and memory peak multiplied by task run time in
+     * seconds, other values and tasks without recorded usage are calculated from limits
+     */
+    static QueuedLimits::Limits actualUsage(const QVariantHash &_task);
+    /**
+     * @brief resources consumed by task
+     * @param _task
+     * task in database format
+     * @return task limits multiplied by task run time in seconds, zero limits if task has not
+     * been run
+     */
+    static QueuedLimits::Limits usage(const QVariantHash &_task);
     /**
      * list of tasks which match criteria
      * @param _user
@@ -94,6 +94,7 @@ typedef QHash<QString, QHash<QString, QString>> QueuedStatusMap;
 template <class T> using QueuedResult = Result::Result<T, QueuedEnums::ReturnStatus>;
 Q_DECLARE_METATYPE(QueuedResult<bool>)
 Q_DECLARE_METATYPE(QueuedResult<long long>)
+Q_DECLARE_METATYPE(QueuedResult<QList<long long>>)
 Q_DECLARE_METATYPE(QueuedResult<QString>)
 Q_DECLARE_METATYPE(QueuedResult<QStringList>)
 Q_DECLARE_METATYPE(QueuedResult<QVariant>)
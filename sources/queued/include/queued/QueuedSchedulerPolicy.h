@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2017 Queued team
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ *
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+/**
+ * @file QueuedSchedulerPolicy.h
+ * Header of Queued library
+ * @author Queued team
+ * @copyright MIT
+ * @bug https://github.com/arcan1s/queued/issues
+ */
+
+
+#ifndef QUEUEDSCHEDULERPOLICY_H
+#define QUEUEDSCHEDULERPOLICY_H
+
+#include "QueuedProcess.h"
+
+
+class QueuedProcessManager;
+
+/**
+ * @brief base class of task selection policies
+ */
+class QueuedSchedulerPolicy
+{
+public:
+    /**
+     * @brief QueuedSchedulerPolicy class constructor
+     * @param _manager
+     * pointer to process manager
+     */
+    explicit QueuedSchedulerPolicy(const QueuedProcessManager *_manager);
+    /**
+     * @brief QueuedSchedulerPolicy class destructor
+     */
+    virtual ~QueuedSchedulerPolicy();
+    /**
+     * @brief create policy by type
+     * @param _policy
+     * policy type
+     * @param _manager
+     * pointer to process manager
+     * @return pointer to created policy
+     */
+    static QueuedSchedulerPolicy *create(const QueuedEnums::SchedulerPolicy _policy,
+                                         const QueuedProcessManager *_manager);
+    /**
+     * @brief may tasks be started before the first one
+     * @return true if backfill should be used after the main pass
+     */
+    virtual bool backfill() const;
+    /**
+     * @brief select next task to start
+     * @remark pending queue must not be empty
+     * @return task index
+     */
+    virtual long long next() const;
+    /**
+     * @brief task position in pending queue
+     * @param _definitions
+     * task definitions
+     * @return task rank, tasks with lower rank go first
+     */
+    virtual long long rank(const QueuedProcess::QueuedProcessDefinitions &_definitions) const = 0;
+    /**
+     * @brief policy type
+     * @return policy type
+     */
+    virtual QueuedEnums::SchedulerPolicy type() const = 0;
+
+protected:
+    /**
+     * @brief pointer to process manager
+     */
+    const QueuedProcessManager *m_manager = nullptr;
+};
+
+
+/**
+ * @brief policy which starts tasks in order of addition
+ */
+class QueuedFifoPolicy : public QueuedSchedulerPolicy
+{
+public:
+    using QueuedSchedulerPolicy::QueuedSchedulerPolicy;
+    /**
+     * @brief task position in pending queue
+     * @return the same rank for all tasks
+     */
+    long long rank(const QueuedProcess::QueuedProcessDefinitions &) const override;
+    /**
+     * @brief policy type
+     * @return policy type
+     */
+    QueuedEnums::SchedulerPolicy type() const override;
+};
+
+
+/**
+ * @brief policy which starts tasks with higher nice level first
+ */
+class QueuedPriorityPolicy : public QueuedSchedulerPolicy
+{
+public:
+    using QueuedSchedulerPolicy::QueuedSchedulerPolicy;
+    /**
+     * @brief task position in pending queue
+     * @param _definitions
+     * task definitions
+     * @return negative nice level
+     */
+    long long rank(const QueuedProcess::QueuedProcessDefinitions &_definitions) const override;
+    /**
+     * @brief policy type
+     * @return policy type
+     */
+    QueuedEnums::SchedulerPolicy type() const override;
+};
+
+
+/**
+ * @brief priority policy which allows tasks to start before the first one if they do not delay it
+ */
+class QueuedBackfillPolicy : public QueuedPriorityPolicy
+{
+public:
+    using QueuedPriorityPolicy::QueuedPriorityPolicy;
+    /**
+     * @brief may tasks be started before the first one
+     * @return always true
+     */
+    bool backfill() const override;
+    /**
+     * @brief policy type
+     * @return policy type
+     */
+    QueuedEnums::SchedulerPolicy type() const override;
+};
+
+
+/**
+ * @brief priority policy which starts tasks of users with lower resource usage first
+ */
+class QueuedFairSharePolicy : public QueuedPriorityPolicy
+{
+public:
+    using QueuedPriorityPolicy::QueuedPriorityPolicy;
+    /**
+     * @brief select next task to start
+     * @remark first tasks of each user are compared by nice level, then by usage
+     * @return task index
+     */
+    long long next() const override;
+    /**
+     * @brief policy type
+     * @return policy type
+     */
+    QueuedEnums::SchedulerPolicy type() const override;
+};
+
+
+/**
+ * @brief policy which starts tasks with lower walltime first
+ */
+class QueuedShortestJobFirstPolicy : public QueuedSchedulerPolicy
+{
+public:
+    using QueuedSchedulerPolicy::QueuedSchedulerPolicy;
+    /**
+     * @brief task position in pending queue
+     * @param _definitions
+     * task definitions
+     * @return task walltime, tasks without estimation go last
+     */
+    long long rank(const QueuedProcess::QueuedProcessDefinitions &_definitions) const override;
+    /**
+     * @brief policy type
+     * @return policy type
+     */
+    QueuedEnums::SchedulerPolicy type() const override;
+};
+
+
+/**
+ * @brief policy which starts tasks with lower deadline slack first
+ */
+class QueuedDeadlinePolicy : public QueuedSchedulerPolicy
+{
+public:
+    using QueuedSchedulerPolicy::QueuedSchedulerPolicy;
+    /**
+     * @brief task position in pending queue
+     * @param _definitions
+     * task definitions
+     * @remark slack is time left before deadline minus walltime. It decreases equally for all
+     * pending tasks, thus the latest start time gives the same order
+     * @return the latest start time which allows to finish task in time, tasks without deadline
+     * go last
+     */
+    long long rank(const QueuedProcess::QueuedProcessDefinitions &_definitions) const override;
+    /**
+     * @brief policy type
+     * @return policy type
+     */
+    QueuedEnums::SchedulerPolicy type() const override;
+};
+
+
+#endif /* QUEUEDSCHEDULERPOLICY_H */
@@ -37,6 +37,10 @@
  */
 namespace QueuedConfig
 {
+/**
+ * @brief placeholder which is replaced by task position in array tasks
+ */
+static const char ARRAY_INDEX_PLACEHOLDER[] = "${QUEUED_ARRAY_INDEX}";
 /**
  * @struct QueuedAdminSetup
  * @brief structure to define administrator user
@@ -81,20 +85,38 @@ struct QueuedDBSetup {
  * @brief settings keys enum
  * @var QueuedSettings::Invalid
  * unknown key
+ * @var QueuedSettings::AdmissionHysteresis
+ * usage in percents below threshold required to admit tasks again after overload
+ * @var QueuedSettings::AdmissionInterval
+ * maximal interval of resource usage sampling in msecs, 0 to admit tasks by declared limits
+ * @var QueuedSettings::AdmissionMargin
+ * resources in percents which are kept free by usage based admission
+ * @var QueuedSettings::CpuPinning
+ * pin every task to dedicated CPU cores of the same NUMA node if possible
  * @var QueuedSettings::DatabaseInterval
  * database actions interval in msecs
  * @var QueuedSettings::DatabaseVersion
  * internal field to control current database version
  * @var QueuedSettings::DefaultLimits
  * default limits value
+ * @var QueuedSettings::FairShareHalfLife
+ * period in seconds after which resource usage is decreased twice
+ * @var QueuedSettings::GroupPool
+ * count of control groups which are created in advance, 0 to create group on task start
  * @var QueuedSettings::KeepTasks
  * keep ended tasks in msecs
  * @var QueuedSettings::KeepUsers
  * keep users last logged in msecs
+ * @var QueuedSettings::MaxArraySize
+ * maximal count of tasks which may be added as single array
  * @var QueuedSettings::OnExitAction
  * on queued exit action enum
  * @var QueuedSettings::Plugins
  * plugin list
+ * @var QueuedSettings::Preemption
+ * action with running tasks of lower priority, one of none, suspend, requeue
+ * @var QueuedSettings::SchedulerPolicy
+ * policy which is used to select tasks to start
  * @var QueuedSettings::ServerAddress
  * queued server bind address
  * @var QueuedSettings::ServerMaxConnections
@@ -105,21 +127,33 @@ struct QueuedDBSetup {
  * server thread timeout
  * @var QueuedSettings::TokenExpiration
  * token expiration value in days
+ * @var QueuedSettings::UsageInterval
+ * the shortest interval of running tasks usage sampling in msecs, 0 to disable sampling
  */
 enum class QueuedSettings {
     Invalid,
+    AdmissionHysteresis,
+    AdmissionInterval,
+    AdmissionMargin,
+    CpuPinning,
     DatabaseInterval,
     DatabaseVersion,
     DefaultLimits,
+    FairShareHalfLife,
+    GroupPool,
     KeepTasks,
     KeepUsers,
+    MaxArraySize,
     OnExitAction,
     Plugins,
+    Preemption,
+    SchedulerPolicy,
     ServerAddress,
     ServerMaxConnections,
     ServerPort,
     ServerTimeout,
-    TokenExpiration
+    TokenExpiration,
+    UsageInterval
 };
 /**
  * @struct QueuedSettingsField
@@ -144,18 +178,28 @@ typedef QHash<QString, QueuedSettingsField> QueuedSettingsDefaultMap;
  */
 static const QueuedSettingsDefaultMap QueuedSettingsDefaults = {
     {"", {QueuedSettings::Invalid, QVariant(), false}},
+    {"AdmissionHysteresis", {QueuedSettings::AdmissionHysteresis, 5, false}},
+    {"AdmissionInterval", {QueuedSettings::AdmissionInterval, 0, false}},
+    {"AdmissionMargin", {QueuedSettings::AdmissionMargin, 10, false}},
+    {"CpuPinning", {QueuedSettings::CpuPinning, false, false}},
     {"DatabaseInterval", {QueuedSettings::DatabaseInterval, 86400000, true}},
     {"DatabaseVersion", {QueuedSettings::DatabaseVersion, QueuedConfig::DATABASE_VERSION, true}},
     {"DefaultLimits", {QueuedSettings::DefaultLimits, "0\n0\n0\n0\n0", false}},
+    {"FairShareHalfLife", {QueuedSettings::FairShareHalfLife, 604800, false}},
+    {"GroupPool", {QueuedSettings::GroupPool, 0, false}},
     {"KeepTasks", {QueuedSettings::KeepTasks, 0, false}},
     {"KeepUsers", {QueuedSettings::KeepUsers, 0, false}},
+    {"MaxArraySize", {QueuedSettings::MaxArraySize, 1000, false}},
     {"OnExitAction", {QueuedSettings::OnExitAction, 2, false}},
     {"Plugins", {QueuedSettings::Plugins, "", false}},
+    {"Preemption", {QueuedSettings::Preemption, "none", false}},
+    {"SchedulerPolicy", {QueuedSettings::SchedulerPolicy, "priority", false}},
     {"ServerAddress", {QueuedSettings::ServerAddress, "", false}},
     {"ServerMaxConnections", {QueuedSettings::ServerMaxConnections, 30, false}},
     {"ServerPort", {QueuedSettings::ServerPort, 8080, false}},
     {"ServerTimeout", {QueuedSettings::ServerTimeout, -1, false}},
     {"TokenExpiration", {QueuedSettings::TokenExpiration, 30, false}},
+    {"UsageInterval", {QueuedSettings::UsageInterval, 5000, false}},
 };
 }; // namespace QueuedConfig
 
@@ -24,6 +24,8 @@
 #ifndef QUEUEDSYSTEMINFO_H
 #define QUEUEDSYSTEMINFO_H
 
+#include <QMap>
+
 
 /**
  * @addtogroup QueuedSystemInfo
@@ -31,6 +33,12 @@
  */
 namespace QueuedSystemInfo
 {
+/**
+ * @brief CPU cores which may be used by daemon
+ * @remark cores are read once from daemon affinity mask, which follows its cpuset as well
+ * @return sorted list of CPU core numbers
+ */
+QList<long long> allowedCores();
 /**
  * @brief system CPU count
  * @return system CPU count
@@ -55,6 +63,29 @@ long long memoryCount();
  * @return weight as proportion
  */
 double memoryWeight(const long long _memory);
+/**
+ * @brief NUMA topology
+ * @remark topology is read once, if it is not available all cores belong to node 0. Only
+ * cores which may be used by daemon are included
+ * @return map of NUMA node numbers to their CPU cores
+ */
+QMap<long long, QList<long long>> numaNodes();
+/**
+ * @brief parse list of ranges which is used by kernel, e.g. 0-3,8
+ * @param _list
+ * list of ranges
+ * @return list of numbers
+ */
+QList<long long> parseRangeList(const QString &_list);
+/**
+ * @brief override system size
+ * @param _cpu
+ * CPU count, 0 to use actual one
+ * @param _memory
+ * memory in bytes, 0 to use actual one
+ * @remark it is used by simulation, overridden CPU cores belong to single NUMA node
+ */
+void setSystemSize(const long long _cpu, const long long _memory);
 } // namespace QueuedSystemInfo
 
 
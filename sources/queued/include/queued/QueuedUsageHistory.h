@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2017 Queued team
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ *
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+/**
+ * @file QueuedUsageHistory.h
+ * Header of Queued library
+ * @author Queued team
+ * @copyright MIT
+ * @bug https://github.com/arcan1s/queued/issues
+ */
+
+
+#ifndef QUEUEDUSAGEHISTORY_H
+#define QUEUEDUSAGEHISTORY_H
+
+#include <QStringList>
+#include <QVector>
+
+
+/**
+ * @brief ring buffer of resources used by task
+ * @remark memory usage does not depend on task run time, the oldest samples are overwritten
+ */
+class QueuedUsageHistory
+{
+public:
+    /**
+     * @struct QueuedUsagePoint
+     * @brief resources used by task at sample time
+     * @var QueuedUsagePoint::time
+     * sample time in milliseconds since epoch
+     * @var QueuedUsagePoint::cpu
+     * used CPU cores since previous sample
+     * @var QueuedUsagePoint::memory
+     * resident memory in bytes
+     * @var QueuedUsagePoint::memoryPeak
+     * the highest memory usage in bytes
+     * @var QueuedUsagePoint::io
+     * bytes read and written per second since previous sample
+     * @var QueuedUsagePoint::pids
+     * count of processes
+     */
+    struct QueuedUsagePoint {
+        long long time = 0;
+        double cpu = 0.0;
+        long long memory = 0;
+        long long memoryPeak = 0;
+        long long io = 0;
+        long long pids = 0;
+    };
+
+    /**
+     * @brief count of stored samples
+     */
+    static const int CAPACITY = 120;
+
+    /**
+     * @brief add sample, the oldest one is removed if buffer is full
+     * @param _point
+     * new sample
+     */
+    void append(const QueuedUsagePoint &_point);
+    /**
+     * @brief count of stored samples
+     * @return count of samples
+     */
+    int count() const;
+    /**
+     * @brief the last sample
+     * @return the newest sample or empty one if there are no samples
+     */
+    QueuedUsagePoint last() const;
+    /**
+     * @brief stored samples
+     * @return samples from the oldest to the newest
+     */
+    QVector<QueuedUsagePoint> points() const;
+    /**
+     * @brief sample string representation
+     * @param _point
+     * sample to convert
+     * @return ISO time, CPU, memory, memory peak, IO and processes separated by space
+     */
+    static QString toString(const QueuedUsagePoint &_point);
+    /**
+     * @brief samples string representation
+     * @return list of samples from the oldest to the newest
+     */
+    QStringList toStringList() const;
+
+private:
+    /**
+     * @brief index of the oldest sample if buffer is full
+     */
+    int m_head = 0;
+    /**
+     * @brief stored samples
+     */
+    QVector<QueuedUsagePoint> m_points;
+};
+
+
+#endif /* QUEUEDUSAGEHISTORY_H */
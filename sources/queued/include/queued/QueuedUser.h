@@ -50,6 +50,8 @@ class QueuedUser : public QObject
     Q_PROPERTY(uint priority READ priority WRITE setPriority)
     // limits
     Q_PROPERTY(QString limits READ limits WRITE setLimits)
+    Q_PROPERTY(long long maxTasks READ maxTasks WRITE setMaxTasks)
+    Q_PROPERTY(QString quota READ quota WRITE setQuota)
 
 public:
     /**
@@ -65,6 +67,10 @@ public:
      * user permissions
      * @var limits
      * user defined limits
+     * @var maxTasks
+     * maximal count of running tasks, 0 means unlimited
+     * @var quota
+     * maximal resources reserved by all running tasks, zero values mean unlimited
      */
     struct QueuedUserDefinitions {
         QString name;
@@ -73,6 +79,8 @@ public:
         uint permissions = 0;
         uint priority = 0;
         QString limits;
+        long long maxTasks = 0;
+        QString quota;
     };
 
     /**
@@ -156,6 +164,11 @@ public:
      * @return user limits in native format
      */
     QueuedLimits::Limits nativeLimits() const;
+    /**
+     * @brief user quota
+     * @return user quota in native format
+     */
+    QueuedLimits::Limits nativeQuota() const;
     /**
      * @brief user password
      * @return SHA512 of user password
@@ -177,6 +190,16 @@ public:
      * @return user limits
      */
     QString limits() const;
+    /**
+     * @brief user max running tasks
+     * @return maximal count of running tasks
+     */
+    long long maxTasks() const;
+    /**
+     * @brief user quota
+     * @return maximal resources of all running tasks
+     */
+    QString quota() const;
     // main properties
     /**
      * @brief set user email
@@ -215,6 +238,18 @@ public:
      * new user limits
      */
     void setLimits(const QString &_limits);
+    /**
+     * @brief set max running tasks
+     * @param _maxTasks
+     * new maximal count of running tasks
+     */
+    void setMaxTasks(const long long _maxTasks);
+    /**
+     * @brief set quota
+     * @param _quota
+     * new user quota
+     */
+    void setQuota(const QString &_quota);
     /**
      * @brief equal operator implementation
      * @param _other
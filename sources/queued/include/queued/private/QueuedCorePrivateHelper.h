@@ -98,6 +98,44 @@ private:
      * @return payload with dropped keys
      */
     QVariantHash dropAdminFields(const QString &_table, const QVariantHash &_payload);
+    /**
+     * @brief convert task dependencies to database payload
+     * @param _dependencies
+     * task dependencies in type:task format
+     * @return list of dependencies payload without task ID or error if dependency is invalid
+     */
+    QueuedResult<QList<QVariantHash>> dependenciesPayload(const QStringList &_dependencies);
+    /**
+     * @brief convert task parameters to database payload
+     * @param _command
+     * command line
+     * @param _arguments
+     * command arguments
+     * @param _workingDirectory
+     * working directory
+     * @param _userId
+     * task owner user ID
+     * @param _nice
+     * task nice level
+     * @param _limits
+     * task defined limits
+     * @param _walltime
+     * estimated task run time in seconds
+     * @param _gang
+     * count of cooperating processes which require dedicated CPU cores, 0 to disable
+     * @param _startAfter
+     * time before which task may not be started, invalid to start any time
+     * @param _deadline
+     * time by which task should be finished, invalid if there is no deadline
+     * @return task payload or error if user could not be found
+     */
+    QueuedResult<QVariantHash> taskPayload(const QString &_command, const QStringList &_arguments,
+                                           const QString &_workingDirectory,
+                                           const long long _userId, const uint _nice,
+                                           const QueuedLimits::Limits &_limits,
+                                           const long long _walltime, const uint _gang,
+                                           const QDateTime &_startAfter,
+                                           const QDateTime &_deadline);
     /**
      * @brief method allows to init class if it was not created
      * @tparam T
@@ -116,6 +154,61 @@ private:
         return _dest ? _dest : new T(m_core, _args...);
     };
     // private interfaces
+    /**
+     * @brief add resources reservation
+     * @param _user
+     * user ID who may use reserved resources
+     * @param _limits
+     * reserved resources
+     * @param _start
+     * start of the first window
+     * @param _end
+     * end of the first window
+     * @param _period
+     * window repeat period in seconds
+     * @return reservation ID or -1 if no reservation added
+     */
+    QueuedResult<long long> addReservationPrivate(const long long _user,
+                                                  const QueuedLimits::Limits &_limits,
+                                                  const QDateTime &_start, const QDateTime &_end,
+                                                  const long long _period);
+    /**
+     * @brief add new array task
+     * @param _command
+     * command line
+     * @param _arguments
+     * command arguments
+     * @param _workingDirectory
+     * working directory
+     * @param _userId
+     * task owner user ID
+     * @param _nice
+     * task nice level
+     * @param _limits
+     * task defined limits
+     * @param _walltime
+     * estimated task run time in seconds
+     * @param _gang
+     * count of cooperating processes which require dedicated CPU cores, 0 to disable
+     * @param _startAfter
+     * time before which task may not be started, invalid to start any time
+     * @param _deadline
+     * time by which task should be finished, invalid if there is no deadline
+     * @param _dependencies
+     * task dependencies in type:task format
+     * @param _count
+     * number of tasks in array
+     * @remark array index placeholder in command, arguments and working directory is replaced
+     * by task position in array starting from 0
+     * @return list of task IDs
+     */
+    QueuedResult<QList<long long>>
+    addTaskArrayPrivate(const QString &_command, const QStringList &_arguments,
+                        const QString &_workingDirectory, const long long _userId,
+                        const uint _nice, const QueuedLimits::Limits &_limits,
+                        const long long _walltime, const uint _gang,
+                        const QDateTime &_startAfter, const QDateTime &_deadline,
+                        const QStringList &_dependencies, const long long _count);
     /**
      * @brief add new task
      * @param _command
@@ -130,12 +223,26 @@ private:
      * task nice level
      * @param _limits
      * task defined limits
+     * @param _walltime
+     * estimated task run time in seconds
+     * @param _gang
+     * count of cooperating processes which require dedicated CPU cores, 0 to disable
+     * @param _startAfter
+     * time before which task may not be started, invalid to start any time
+     * @param _deadline
+     * time by which task should be finished, invalid if there is no deadline
+     * @param _dependencies
+     * task dependencies in type:task format
      * @return task ID or -1 if no task added
      */
     QueuedResult<long long> addTaskPrivate(const QString &_command, const QStringList &_arguments,
                                            const QString &_workingDirectory,
                                            const long long _userId, const uint _nice,
-                                           const QueuedLimits::Limits &_limits);
+                                           const QueuedLimits::Limits &_limits,
+                                           const long long _walltime, const uint _gang,
+                                           const QDateTime &_startAfter,
+                                           const QDateTime &_deadline,
+                                           const QStringList &_dependencies);
     /**
      * @brief add new user
      * @param _name
@@ -212,10 +319,19 @@ private:
     QueuedResult<bool> editUserPermissionPrivate(const long long _id,
                                                  const QueuedEnums::Permission &_permission,
                                                  const bool _add);
+    /**
+     * @brief remove resources reservation
+     * @param _id
+     * reservation ID
+     * @return true on successful reservation removal
+     */
+    QueuedResult<bool> removeReservationPrivate(const long long _id);
     /**
      * @brief try get task from storages
      * @param _id
      * task ID to search
+     * @remark objects of tasks which are not running are temporary and are deleted on the next
+     * event loop iteration, thus pointer must not be stored
      * @return pointer to found task if any
      */
     QueuedProcess *tryGetTask(const long long _id);
@@ -24,6 +24,13 @@
 #include <queued/Queued.h>
 
 #include <QDir>
+#include <QFileInfo>
+
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
 
 
 /**
@@ -68,6 +75,9 @@ QString QueuedControlGroupsAdaptor::groupPath(const QString &_base) const
  */
 QStringList QueuedControlGroupsAdaptor::controlPaths()
 {
+    // all controllers share the same group in unified hierarchy
+    if (unified())
+        return {unifiedPath()};
     return {cpuPath(), memoryPath()};
 }
 
@@ -77,37 +87,260 @@ QStringList QueuedControlGroupsAdaptor::controlPaths()
  */
 QString QueuedControlGroupsAdaptor::cpuPath()
 {
+    if (unified())
+        return unifiedPath();
     return QDir(QueuedConfig::CG_FS_PATH).filePath("cpu");
 }
 
 
+/**
+ * @fn cpusetAvailable
+ */
+bool QueuedControlGroupsAdaptor::cpusetAvailable()
+{
+    if (unified())
+        return true;
+    return QFileInfo(QDir(cpusetPath()).filePath(CG_CPUSET_CPUS)).isWritable();
+}
+
+
+/**
+ * @fn cpusetPath
+ */
+QString QueuedControlGroupsAdaptor::cpusetPath()
+{
+    if (unified())
+        return unifiedPath();
+    return QDir(QueuedConfig::CG_FS_PATH).filePath("cpuset");
+}
+
+
 /**
  * @fn memoryPath
  */
 QString QueuedControlGroupsAdaptor::memoryPath()
 {
+    if (unified())
+        return unifiedPath();
     return QDir(QueuedConfig::CG_FS_PATH).filePath("memory");
 }
 
 
+/**
+ * @fn prepareHierarchy
+ */
+bool QueuedControlGroupsAdaptor::prepareHierarchy()
+{
+    if (!unified())
+        return true;
+
+    QDir base(unifiedPath());
+    qCInfo(LOG_LIB) << "Prepare unified control groups hierarchy in" << base.path();
+
+    // root group is the only one which may contain both processes and child groups
+    if (base != QDir(QueuedConfig::CG_FS_PATH)) {
+        if (!base.mkpath(CG_DAEMON_GROUP)) {
+            qCCritical(LOG_LIB) << "Could not create daemon group in" << base.path();
+            return false;
+        }
+        QFile procs(base.filePath(CG_PROC_FILE));
+        if (!procs.open(QIODevice::ReadOnly | QFile::Text)) {
+            qCCritical(LOG_LIB) << "Could not read processes of" << base.path();
+            return false;
+        }
+        // every pid requires its own write
+        auto pids = QString(procs.readAll()).split('\n', QString::SkipEmptyParts);
+        auto leaf = QDir(base.filePath(CG_DAEMON_GROUP)).filePath(CG_PROC_FILE);
+        for (auto &pid : pids) {
+            // process might exit after list has been read
+            if (!writeControl(leaf, pid.toLatin1()) && (errno != ESRCH)) {
+                qCCritical(LOG_LIB) << "Could not move" << pid << "to" << leaf;
+                return false;
+            }
+        }
+    }
+
+    // enable controllers one by one, so unavailable one does not disable others
+    QFile controllers(base.filePath(CG_CONTROLLERS_FILE));
+    if (!controllers.open(QIODevice::ReadOnly | QFile::Text)) {
+        qCCritical(LOG_LIB) << "Could not read controllers of" << base.path();
+        return false;
+    }
+    bool status = true;
+    for (auto &controller : QString(controllers.readAll()).simplified().split(' ')) {
+        if (!QStringList({"cpu", "cpuset", "io", "memory", "pids"}).contains(controller))
+            continue;
+        auto value = QString("+%1").arg(controller).toLatin1();
+        if (!writeControl(base.filePath(CG_SUBTREE_CONTROL_FILE), value)) {
+            qCWarning(LOG_LIB) << "Could not enable controller" << controller;
+            status = false;
+        }
+    }
+
+    return status;
+}
+
+
+/**
+ * @fn unified
+ */
+bool QueuedControlGroupsAdaptor::unified()
+{
+    // root of unified hierarchy contains list of available controllers
+    static const bool isUnified
+        = QFile::exists(QDir(QueuedConfig::CG_FS_PATH).filePath(CG_CONTROLLERS_FILE));
+
+    return isUnified;
+}
+
+
+/**
+ * @fn unifiedPath
+ */
+QString QueuedControlGroupsAdaptor::unifiedPath()
+{
+    // group is read once, because daemon is moved to its leaf later
+    static const QString path = []() {
+        QString group = "/";
+        QFile file("/proc/self/cgroup");
+        if (file.open(QIODevice::ReadOnly | QFile::Text)) {
+            QTextStream stream(&file);
+            // unified hierarchy is always described by line with zero id
+            while (!stream.atEnd()) {
+                auto line = stream.readLine();
+                if (line.startsWith("0::")) {
+                    group = line.mid(3);
+                    break;
+                }
+            }
+        } else {
+            qCWarning(LOG_LIB) << "Could not read daemon control group, use root one";
+        }
+        return QDir::cleanPath(QString("%1/%2").arg(QueuedConfig::CG_FS_PATH).arg(group));
+    }();
+
+    return path;
+}
+
+
 /**
  * @fn cpuLimit
  */
 long long QueuedControlGroupsAdaptor::cpuLimit() const
 {
-    QFile file(QDir(groupPath(cpuPath())).filePath(CG_CPU_LIMIT));
-
-    long long limit = 0;
-    if (file.open(QIODevice::ReadOnly | QFile::Text)) {
-        QTextStream stream(&file);
-        limit = stream.readAll().toLongLong();
-    } else {
+    QByteArray value;
+    if (!readFile(controlFile(cpuPath(), unified() ? CG_CPU_MAX : CG_CPU_LIMIT), value)) {
         qCCritical(LOG_LIB) << "Could not get CPU limit" << name();
         return 0;
     }
-    file.close();
+    // unified hierarchy stores both quota and period in the same file
+    auto fields = value.trimmed().split(' ');
+    QByteArray period = (fields.count() > 1) ? fields.at(1) : QByteArray();
+    if (!unified() && !readFile(controlFile(cpuPath(), CG_CPU_PERIOD), period)) {
+        qCCritical(LOG_LIB) << "Could not get CPU period" << name();
+        return 0;
+    }
+    // quota is either "max" or -1 if group is not limited
+    auto quota = fields.first().toLongLong();
+    auto length = period.trimmed().toLongLong();
+    if ((quota <= 0) || (length <= 0))
+        return 0;
 
-    return limit * QueuedSystemInfo::cpuCount() / 1000;
+    return std::llround(static_cast<double>(quota) / static_cast<double>(length));
+}
+
+
+/**
+ * @fn cpuSet
+ */
+QList<long long> QueuedControlGroupsAdaptor::cpuSet() const
+{
+    QByteArray value;
+    if (!readFile(controlFile(cpusetPath(), CG_CPUSET_CPUS), value)) {
+        qCWarning(LOG_LIB) << "Could not get CPU cores" << name();
+        return QList<long long>();
+    }
+
+    return QueuedSystemInfo::parseRangeList(QString::fromLatin1(value));
+}
+
+
+/**
+ * @fn cpusetEnabled
+ */
+bool QueuedControlGroupsAdaptor::cpusetEnabled() const
+{
+    return unified() || m_cpuset;
+}
+
+
+/**
+ * @fn cpuUsage
+ */
+long long QueuedControlGroupsAdaptor::cpuUsage() const
+{
+    QByteArray value;
+    if (!readFile(controlFile(cpuPath(), unified() ? CG_CPU_STAT : CG_CPU_USAGE), value)) {
+        qCWarning(LOG_LIB) << "Could not get CPU usage" << name();
+        return 0;
+    }
+
+    if (!unified())
+        return value.trimmed().toLongLong();
+    // file consists of key value pairs, usage is in microseconds
+    for (auto &line : value.split('\n')) {
+        auto fields = line.split(' ');
+        if ((fields.count() == 2) && (fields.first() == "usage_usec"))
+            return fields.last().toLongLong() * 1000;
+    }
+
+    return 0;
+}
+
+
+/**
+ * @fn eventsFile
+ */
+QString QueuedControlGroupsAdaptor::eventsFile() const
+{
+    return unified() ? controlFile(unifiedPath(), CG_EVENTS_FILE) : QString();
+}
+
+
+/**
+ * @fn ioUsage
+ */
+long long QueuedControlGroupsAdaptor::ioUsage() const
+{
+    // blkio is not controlled in legacy hierarchy
+    if (!unified())
+        return 0;
+
+    QByteArray value;
+    if (!readFile(controlFile(cpuPath(), CG_IO_STAT), value)) {
+        qCWarning(LOG_LIB) << "Could not get IO usage" << name();
+        return 0;
+    }
+
+    // every line contains device and its key value pairs
+    long long usage = 0;
+    for (auto &line : value.split('\n')) {
+        for (auto &field : line.split(' ')) {
+            if (field.startsWith("rbytes=") || field.startsWith("wbytes="))
+                usage += field.mid(field.indexOf('=') + 1).toLongLong();
+        }
+    }
+
+    return usage;
+}
+
+
+/**
+ * @fn memoryEventsFile
+ */
+QString QueuedControlGroupsAdaptor::memoryEventsFile() const
+{
+    return unified() ? controlFile(memoryPath(), CG_MEMORY_EVENTS) : QString();
 }
 
 
@@ -116,19 +349,68 @@ long long QueuedControlGroupsAdaptor::cpuLimit() const
  */
 long long QueuedControlGroupsAdaptor::memoryLimit() const
 {
-    QFile file(QDir(groupPath(memoryPath())).filePath(CG_MEMORY_LIMIT));
-
-    long long limit = 0;
-    if (file.open(QIODevice::ReadOnly | QFile::Text)) {
-        QTextStream stream(&file);
-        limit = stream.readAll().toLongLong();
-    } else {
+    QByteArray value;
+    if (!readFile(controlFile(memoryPath(), unified() ? CG_MEMORY_MAX : CG_MEMORY_LIMIT), value)) {
         qCCritical(LOG_LIB) << "Could not get memory limit" << name();
         return 0;
     }
-    file.close();
 
-    return limit;
+    // unlimited value of unified hierarchy is read as 0
+    return value.trimmed().toLongLong();
+}
+
+
+/**
+ * @fn memoryPeak
+ */
+long long QueuedControlGroupsAdaptor::memoryPeak() const
+{
+    QByteArray value;
+    if (!readFile(controlFile(memoryPath(), unified() ? CG_MEMORY_PEAK : CG_MEMORY_MAX_USAGE),
+                  value)) {
+        qCWarning(LOG_LIB) << "Could not get memory peak" << name();
+        return 0;
+    }
+
+    return value.trimmed().toLongLong();
+}
+
+
+/**
+ * @fn memorySet
+ */
+QList<long long> QueuedControlGroupsAdaptor::memorySet() const
+{
+    QByteArray value;
+    if (!readFile(controlFile(cpusetPath(), CG_CPUSET_MEMS), value)) {
+        qCWarning(LOG_LIB) << "Could not get memory nodes" << name();
+        return QList<long long>();
+    }
+
+    return QueuedSystemInfo::parseRangeList(QString::fromLatin1(value));
+}
+
+
+/**
+ * @fn memoryUsage
+ */
+long long QueuedControlGroupsAdaptor::memoryUsage() const
+{
+    QByteArray value;
+    if (!readFile(controlFile(memoryPath(), CG_MEMORY_STAT), value)) {
+        qCWarning(LOG_LIB) << "Could not get memory usage" << name();
+        return 0;
+    }
+
+    // file consists of key value pairs, both keys include child groups
+    auto key = unified() ? "anon" : "total_rss";
+    for (auto &line : value.split('\n')) {
+        auto fields = line.split(' ');
+        if ((fields.count() == 2) && (fields.first() == key))
+            return fields.last().toLongLong();
+    }
+
+    return 0;
 }
 
 
@@ -141,6 +423,76 @@ QString QueuedControlGroupsAdaptor::name() const
 }
 
 
+/**
+ * @fn oomKills
+ */
+long long QueuedControlGroupsAdaptor::oomKills() const
+{
+    QByteArray value;
+    if (!readFile(controlFile(memoryPath(), unified() ? CG_MEMORY_EVENTS : CG_MEMORY_OOM_CONTROL),
+                  value)) {
+        qCWarning(LOG_LIB) << "Could not get OOM kills" << name();
+        return 0;
+    }
+
+    // both files consist of key value pairs, counter is missing in old kernels
+    for (auto &line : value.split('\n')) {
+        auto fields = line.split(' ');
+        if ((fields.count() == 2) && (fields.first() == "oom_kill"))
+            return fields.last().toLongLong();
+    }
+
+    return 0;
+}
+
+
+/**
+ * @fn pidsCount
+ */
+long long QueuedControlGroupsAdaptor::pidsCount() const
+{
+    QByteArray value;
+    if (!readFile(controlFile(cpuPath(), unified() ? CG_PIDS_CURRENT : CG_PROC_FILE), value)) {
+        qCWarning(LOG_LIB) << "Could not get processes count" << name();
+        return 0;
+    }
+
+    // legacy hierarchy contains list of processes instead
+    return unified() ? value.trimmed().toLongLong() : value.count('\n');
+}
+
+
+/**
+ * @fn paths
+ */
+QStringList QueuedControlGroupsAdaptor::paths() const
+{
+    auto output = controlPaths();
+    if (!unified() && m_cpuset)
+        output.append(cpusetPath());
+
+    return output;
+}
+
+
+/**
+ * @fn populated
+ */
+bool QueuedControlGroupsAdaptor::populated() const
+{
+    if (!unified())
+        return pidsCount() > 0;
+
+    QByteArray value;
+    if (!readFile(controlFile(unifiedPath(), CG_EVENTS_FILE), value)) {
+        qCWarning(LOG_LIB) << "Could not get group state" << name();
+        return false;
+    }
+
+    return value.contains("populated 1");
+}
+
+
 /**
  * @fn setCpuLimit
  */
@@ -148,17 +500,40 @@ void QueuedControlGroupsAdaptor::setCpuLimit(const long long _value)
 {
     qCDebug(LOG_LIB) << "Set new CPU limit to" << _value;
 
-    QFile file(QDir(groupPath(cpuPath())).filePath(CG_CPU_LIMIT));
+    auto period = QByteArray::number(CPU_PERIOD);
+    auto quota = QByteArray::number(_value * CPU_PERIOD);
+    if (unified()) {
+        // quota and period are written at once, kernel rejects quota less than 1ms
+        auto value = (_value <= 0) ? QByteArray("max ") + period : quota + ' ' + period;
+        if (!writeFile(controlFile(cpuPath(), CG_CPU_MAX), value))
+            qCCritical(LOG_LIB) << "Could not set CPU limit" << name() << "to" << _value;
+        return;
+    }
 
-    if (file.open(QIODevice::WriteOnly)) {
-        QTextStream stream(&file);
-        stream << _value;
-        stream.flush();
-    } else {
+    if (_value <= 0)
+        quota = "-1";
+    if (!writeFile(controlFile(cpuPath(), CG_CPU_PERIOD), period)
+        || !writeFile(controlFile(cpuPath(), CG_CPU_LIMIT), quota))
         qCCritical(LOG_LIB) << "Could not set CPU limit" << name() << "to" << _value;
+}
+
+
+/**
+ * @fn setCpuSet
+ */
+void QueuedControlGroupsAdaptor::setCpuSet(const QList<long long> &_cpus)
+{
+    qCDebug(LOG_LIB) << "Set new CPU cores to" << _cpus;
+
+    if (!enableCpuSet()) {
+        qCWarning(LOG_LIB) << "Could not set CPU cores" << name() << "without cpuset";
         return;
     }
-    file.close();
+    QByteArrayList cpus;
+    for (auto cpu : _cpus)
+        cpus.append(QByteArray::number(cpu));
+    if (!writeFile(controlFile(cpusetPath(), CG_CPUSET_CPUS), cpus.join(',')))
+        qCCritical(LOG_LIB) << "Could not set CPU cores" << name() << "to" << cpus;
 }
 
 
@@ -169,19 +544,39 @@ void QueuedControlGroupsAdaptor::setMemoryLimit(const long long _value)
 {
     qCDebug(LOG_LIB) << "Set new memory limit to" << _value;
 
-    QFile file(QDir(groupPath(memoryPath())).filePath(CG_MEMORY_LIMIT));
-
-    if (file.open(QIODevice::WriteOnly)) {
-        QTextStream stream(&file);
-        stream << _value;
-        stream.flush();
-    } else {
+    auto value = (unified() && (_value <= 0)) ? QByteArray("max") : QByteArray::number(_value);
+    if (!writeFile(controlFile(memoryPath(), unified() ? CG_MEMORY_MAX : CG_MEMORY_LIMIT),
+                   value)) {
         qCCritical(LOG_LIB) << "Could not set memory limit" << name() << "to" << _value;
         return;
     }
-    file.close();
 
-    Q_ASSERT(_value == memoryLimit());
+    // group is throttled and reclaimed before it reaches the hard limit
+    if (!unified())
+        return;
+    auto high
+        = (_value <= 0) ? value : QByteArray::number(std::llround(_value * MEMORY_HIGH_RATIO));
+    if (!writeFile(controlFile(memoryPath(), CG_MEMORY_HIGH), high))
+        qCWarning(LOG_LIB) << "Could not set memory threshold" << name();
+}
+
+
+/**
+ * @fn setMemorySet
+ */
+void QueuedControlGroupsAdaptor::setMemorySet(const QList<long long> &_nodes)
+{
+    qCDebug(LOG_LIB) << "Set new memory nodes to" << _nodes;
+
+    if (!enableCpuSet()) {
+        qCWarning(LOG_LIB) << "Could not set memory nodes" << name() << "without cpuset";
+        return;
+    }
+    QByteArrayList nodes;
+    for (auto node : _nodes)
+        nodes.append(QByteArray::number(node));
+    if (!writeFile(controlFile(cpusetPath(), CG_CPUSET_MEMS), nodes.join(',')))
+        qCCritical(LOG_LIB) << "Could not set memory nodes" << name() << "to" << nodes;
 }
 
 
@@ -192,22 +587,31 @@ bool QueuedControlGroupsAdaptor::addProcess(const uint _pid)
 {
     qCDebug(LOG_LIB) << "Assign add process" << _pid;
 
-    for (auto &path : controlPaths()) {
-        auto proc = QDir(groupPath(path)).filePath(CG_PROC_FILE);
-        QFile file(proc);
-
-        if (file.open(QIODevice::ReadWrite)) {
-            QTextStream stream(&file);
-            stream << _pid;
-        } else {
+    // process is assigned to other controls even if some of them have failed
+    bool status = true;
+    for (auto &path : paths()) {
+        auto proc = controlFile(path, CG_PROC_FILE);
+        if (!writeFile(proc, QByteArray::number(_pid))) {
             qCCritical(LOG_LIB) << "Cound not assign pid" << _pid << "to" << proc;
-            return false;
+            status = false;
         }
-
-        file.close();
     }
 
-    return true;
+    return status;
+}
+
+
+/**
+ * @fn addSelf
+ */
+bool QueuedControlGroupsAdaptor::addSelf(const QList<int> &_files)
+{
+    // zero means the writing process, no memory is allocated here
+    bool status = true;
+    for (auto fd : _files)
+        status &= (::write(fd, "0", 1) == 1);
+
+    return status;
 }
 
 
@@ -218,39 +622,79 @@ bool QueuedControlGroupsAdaptor::createGroup()
 {
     qCDebug(LOG_LIB) << "Create empty group";
 
-    auto paths = controlPaths();
-
-    // create cgroups
-    bool status = std::all_of(paths.cbegin(), paths.cend(),
-                              [this](const QString &path) { return QDir(path).mkpath(name()); });
-    // apply settings
-    status &= std::all_of(paths.cbegin(), paths.cend(), [this](const QString &path) {
-        auto notify = QDir(groupPath(path)).filePath(CG_NOTIFY_ON_RELEASE_FILE);
-        QFile file(notify);
-        if (file.open(QIODevice::WriteOnly)) {
-            QTextStream stream(&file);
-            stream << 1;
-        } else {
-            qCCritical(LOG_LIB) << "Could not apply rules to" << CG_NOTIFY_ON_RELEASE_FILE;
-            return false;
+    // failed control must not prevent limits of other ones
+    bool status = true;
+    for (auto &path : controlPaths()) {
+        if (!QDir(path).mkpath(name()) || !applyReleaseRules(path)) {
+            qCCritical(LOG_LIB) << "Could not create group" << name() << "in" << path;
+            status = false;
         }
+    }
+
+    return status;
+}
+
+
+/**
+ * @fn enableCpuSet
+ */
+bool QueuedControlGroupsAdaptor::enableCpuSet()
+{
+    if (cpusetEnabled())
         return true;
-    });
-    status &= std::all_of(paths.cbegin(), paths.cend(), [this](const QString &path) {
-        auto agent = QDir(groupPath(path)).filePath(CG_RELEASE_FILE);
-        QFile file(agent);
-        if (file.open(QIODevice::WriteOnly)) {
-            QTextStream stream(&file);
-            stream << QString("rmdir \"%1\"").arg(QDir(path).filePath(name()));
-        } else {
-            qCCritical(LOG_LIB) << "Could not apply rules to" << CG_RELEASE_FILE;
+    if (!cpusetAvailable()) {
+        qCWarning(LOG_LIB) << "cpuset control is not available";
+        return false;
+    }
+    qCDebug(LOG_LIB) << "Add cpuset control to group" << name();
+
+    auto path = cpusetPath();
+    if (!QDir(path).mkpath(name()) || !applyReleaseRules(path)) {
+        qCCritical(LOG_LIB) << "Could not create cpuset group" << name();
+        return false;
+    }
+    // cpuset group could not be used until cores and memory nodes are set
+    for (auto &control : {CG_CPUSET_CPUS, CG_CPUSET_MEMS}) {
+        QFile parent(QDir(path).filePath(control));
+        if (!parent.open(QIODevice::ReadOnly | QFile::Text)
+            || !writeFile(controlFile(path, control), parent.readAll())) {
+            qCCritical(LOG_LIB) << "Could not apply rules to" << control;
             return false;
         }
-        return true;
-    });
+    }
+    m_cpuset = true;
+
+    // running processes are moved from root cpuset, memory group contains all of them
+    QByteArray value;
+    if (readFile(controlFile(memoryPath(), CG_PROC_FILE), value)) {
+        for (auto &pid : value.split('\n')) {
+            if (!pid.trimmed().isEmpty())
+                writeFile(controlFile(path, CG_PROC_FILE), pid.trimmed());
+        }
+    }
 
+    return true;
+}
 
-    return status;
+
+/**
+ * @fn processFiles
+ */
+QList<int> QueuedControlGroupsAdaptor::processFiles() const
+{
+    qCDebug(LOG_LIB) << "Get process files of group" << name();
+
+    QList<int> files;
+    for (auto &path : paths()) {
+        int fd = descriptor(controlFile(path, CG_PROC_FILE), O_WRONLY);
+        if (fd < 0) {
+            qCCritical(LOG_LIB) << "Could not open process file of" << path;
+            continue;
+        }
+        files.append(fd);
+    }
+
+    return files;
 }
 
 
@@ -261,8 +705,169 @@ bool QueuedControlGroupsAdaptor::removeGroup()
 {
     qCDebug(LOG_LIB) << "Remove group";
 
-    auto paths = controlPaths();
+    // opened control files should not keep removed group
+    closeFiles();
+    auto groups = paths();
+    m_cpuset = false;
 
-    return std::all_of(paths.cbegin(), paths.cend(),
+    return std::all_of(groups.cbegin(), groups.cend(),
                        [this](const QString &path) { return QDir(path).rmdir(name()); });
 }
+
+
+/**
+ * @fn sendSignal
+ */
+bool QueuedControlGroupsAdaptor::sendSignal(const int _signal) const
+{
+    qCDebug(LOG_LIB) << "Send signal" << _signal << "to group" << name();
+
+    // kernel kills processes which are forked during iteration as well
+    auto killFile = controlFile(unifiedPath(), CG_KILL_FILE);
+    if (unified() && (_signal == SIGKILL) && QFileInfo::exists(killFile)
+        && writeFile(killFile, "1"))
+        return true;
+
+    // memory group contains all processes in legacy hierarchy
+    QByteArray value;
+    if (!readFile(controlFile(memoryPath(), CG_PROC_FILE), value)) {
+        qCWarning(LOG_LIB) << "Could not get processes of group" << name();
+        return false;
+    }
+    bool status = true;
+    for (auto &line : value.split('\n')) {
+        auto pid = line.trimmed().toInt();
+        if ((pid > 0) && (::kill(pid, _signal) != 0)) {
+            qCWarning(LOG_LIB) << "Could not send signal" << _signal << "to" << pid;
+            status = false;
+        }
+    }
+
+    return status;
+}
+
+
+/**
+ * @fn applyReleaseRules
+ */
+bool QueuedControlGroupsAdaptor::applyReleaseRules(const QString &_base) const
+{
+    // unified hierarchy has no release agent, group is removed by adaptor
+    if (unified())
+        return true;
+
+    if (!writeFile(controlFile(_base, CG_NOTIFY_ON_RELEASE_FILE), "1")) {
+        qCCritical(LOG_LIB) << "Could not apply rules to" << CG_NOTIFY_ON_RELEASE_FILE;
+        return false;
+    }
+    auto agent = QString("rmdir \"%1\"").arg(groupPath(_base));
+    if (!writeFile(controlFile(_base, CG_RELEASE_FILE), agent.toUtf8())) {
+        qCCritical(LOG_LIB) << "Could not apply rules to" << CG_RELEASE_FILE;
+        return false;
+    }
+
+    return true;
+}
+
+
+/**
+ * @fn closeFiles
+ */
+void QueuedControlGroupsAdaptor::closeFiles()
+{
+    for (auto fd : m_files)
+        ::close(fd);
+    m_files.clear();
+}
+
+
+/**
+ * @fn controlFile
+ */
+QString QueuedControlGroupsAdaptor::controlFile(const QString &_base, const char *_file) const
+{
+    return QString("%1/%2/%3").arg(_base, name(), _file);
+}
+
+
+/**
+ * @fn descriptor
+ */
+int QueuedControlGroupsAdaptor::descriptor(const QString &_path, const int _flags) const
+{
+    auto key = qMakePair(_path, _flags);
+    if (m_files.contains(key))
+        return m_files[key];
+
+    int fd = ::open(qPrintable(_path), _flags | O_CLOEXEC);
+    if (fd < 0)
+        return fd;
+    m_files[key] = fd;
+
+    return fd;
+}
+
+
+/**
+ * @fn readFile
+ */
+bool QueuedControlGroupsAdaptor::readFile(const QString &_path, QByteArray &_value) const
+{
+    int fd = descriptor(_path, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    // control files are generated on every read from the beginning
+    _value.clear();
+    char buffer[4096];
+    ssize_t count;
+    while ((count = ::pread(fd, buffer, sizeof(buffer), _value.size())) > 0)
+        _value.append(buffer, count);
+    if (count < 0) {
+        // group might be recreated, thus file is reopened on next access
+        ::close(fd);
+        m_files.remove(qMakePair(_path, O_RDONLY));
+        return false;
+    }
+
+    return true;
+}
+
+
+/**
+ * @fn writeControl
+ */
+bool QueuedControlGroupsAdaptor::writeControl(const QString &_path, const QByteArray &_value)
+{
+    // errors are reported by write call, thus value must not be buffered
+    int fd = ::open(qPrintable(_path), O_WRONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+    bool status = ::write(fd, _value.constData(), _value.size()) == _value.size();
+    // close must not overwrite error of write
+    int error = errno;
+    ::close(fd);
+    errno = error;
+
+    return status;
+}
+
+
+/**
+ * @fn writeFile
+ */
+bool QueuedControlGroupsAdaptor::writeFile(const QString &_path, const QByteArray &_value) const
+{
+    int fd = descriptor(_path, O_WRONLY);
+    if (fd < 0)
+        return false;
+
+    // every write is a separate value for kernel, thus it must be done at once
+    if (::write(fd, _value.constData(), _value.size()) != _value.size()) {
+        ::close(fd);
+        m_files.remove(qMakePair(_path, O_WRONLY));
+        return false;
+    }
+
+    return true;
+}
@@ -64,6 +64,20 @@ QueuedResult<bool> QueuedCore::addPlugin(const QString &_plugin, const QString &
 }
 
 
+/**
+ * @fn addReservation
+ */
+QueuedResult<long long> QueuedCore::addReservation(const long long _user,
+                                                   const QueuedLimits::Limits &_limits,
+                                                   const QDateTime &_start, const QDateTime &_end,
+                                                   const long long _period, const QString &_token)
+{
+    qCDebug(LOG_LIB) << "Add reservation for user" << _user << "from" << _start << "to" << _end;
+
+    return m_impl->addReservation(_user, _limits, _start, _end, _period, _token);
+}
+
+
 /**
  * @addTask
  */
@@ -71,13 +85,38 @@ QueuedResult<long long> QueuedCore::addTask(const QString &_command, const QStri
                                             const QString &_workingDirectory,
                                             const long long _userId, const uint _nice,
                                             const QueuedLimits::Limits &_limits,
+                                            const long long _walltime, const uint _gang,
+                                            const QDateTime &_startAfter,
+                                            const QDateTime &_deadline,
+                                            const QStringList &_dependencies,
                                             const QString &_token)
 {
     qCDebug(LOG_LIB) << "Add task" << _command << "with arguments" << _arguments << "from user"
                      << _userId;
 
     return m_impl->addTask(_command, _arguments, _workingDirectory, _userId, _nice, _limits,
-                           _token);
+                           _walltime, _gang, _startAfter, _deadline, _dependencies, _token);
+}
+
+
+/**
+ * @fn addTaskArray
+ */
+QueuedResult<QList<long long>>
+QueuedCore::addTaskArray(const QString &_command, const QStringList &_arguments,
+                         const QString &_workingDirectory, const long long _userId,
+                         const uint _nice, const QueuedLimits::Limits &_limits,
+                         const long long _walltime, const uint _gang,
+                         const QDateTime &_startAfter, const QDateTime &_deadline,
+                         const QStringList &_dependencies, const long long _count,
+                         const QString &_token)
+{
+    qCDebug(LOG_LIB) << "Add" << _count << "tasks" << _command << "with arguments" << _arguments
+                     << "from user" << _userId;
+
+    return m_impl->addTaskArray(_command, _arguments, _workingDirectory, _userId, _nice, _limits,
+                                _walltime, _gang, _startAfter, _deadline, _dependencies, _count,
+                                _token);
 }
 
 
@@ -234,6 +273,26 @@ QueuedResult<bool> QueuedCore::removePlugin(const QString &_plugin, const QStrin
 }
 
 
+/**
+ * @fn removeReservation
+ */
+QueuedResult<bool> QueuedCore::removeReservation(const long long _id, const QString &_token)
+{
+    qCDebug(LOG_LIB) << "Remove reservation" << _id;
+
+    return m_impl->removeReservation(_id, _token);
+}
+
+
+/**
+ * @fn schedulerStatistics
+ */
+QueuedStatusMap QueuedCore::schedulerStatistics() const
+{
+    return m_impl->schedulerStatistics();
+}
+
+
 /**
  * @fn startTask
  */
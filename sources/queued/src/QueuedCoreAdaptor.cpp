@@ -101,6 +101,42 @@ QueuedResult<bool> QueuedCoreAdaptor::sendPluginRemove(const QString &_plugin,
 }
 
 
+/**
+ * @fn sendReservationAdd
+ */
+QueuedResult<long long>
+QueuedCoreAdaptor::sendReservationAdd(const long long _user, const QueuedLimits::Limits &_limits,
+                                      const QDateTime &_start, const QDateTime &_end,
+                                      const long long _period, const QString &_token)
+{
+    qCDebug(LOG_DBUS) << "Add reservation for user" << _user << "from" << _start << "to" << _end;
+
+    QVariantList args = {_user,
+                         _limits.cpu,
+                         _limits.memory,
+                         _start.toString(Qt::ISODateWithMs),
+                         _end.toString(Qt::ISODateWithMs),
+                         _period,
+                         _token};
+    return sendRequest<long long>(QueuedConfig::DBUS_SERVICE, QueuedConfig::DBUS_OBJECT_PATH,
+                                  QueuedConfig::DBUS_SERVICE, "ReservationAdd", args);
+}
+
+
+/**
+ * @fn sendReservationRemove
+ */
+QueuedResult<bool> QueuedCoreAdaptor::sendReservationRemove(const long long _id,
+                                                           const QString &_token)
+{
+    qCDebug(LOG_DBUS) << "Remove reservation" << _id;
+
+    QVariantList args = {_id, _token};
+    return sendRequest<bool>(QueuedConfig::DBUS_SERVICE, QueuedConfig::DBUS_OBJECT_PATH,
+                             QueuedConfig::DBUS_SERVICE, "ReservationRemove", args);
+}
+
+
 /**
  * @fn sendTaskAdd
  */
@@ -111,6 +147,9 @@ QueuedCoreAdaptor::sendTaskAdd(const QueuedProcess::QueuedProcessDefinitions &_d
     qCDebug(LOG_DBUS) << "Add task" << _definitions.command;
 
     auto limits = QueuedLimits::Limits(_definitions.limits);
+    QStringList dependencies;
+    for (auto &dependency : _definitions.dependencies)
+        dependencies.append(dependency.toString());
     QVariantList args = {_definitions.command,
                          _definitions.arguments,
                          _definitions.workingDirectory,
@@ -121,12 +160,53 @@ QueuedCoreAdaptor::sendTaskAdd(const QueuedProcess::QueuedProcessDefinitions &_d
                          limits.memory,
                          limits.gpumemory,
                          limits.storage,
+                         _definitions.walltime,
+                         _definitions.gang,
+                         _definitions.startAfter.toString(Qt::ISODateWithMs),
+                         _definitions.deadline.toString(Qt::ISODateWithMs),
+                         dependencies,
                          _token};
     return sendRequest<long long>(QueuedConfig::DBUS_SERVICE, QueuedConfig::DBUS_OBJECT_PATH,
                                   QueuedConfig::DBUS_SERVICE, "TaskAdd", args);
 }
 
 
+/**
+ * @fn sendTaskAddArray
+ */
+QueuedResult<QList<long long>>
+QueuedCoreAdaptor::sendTaskAddArray(const QueuedProcess::QueuedProcessDefinitions &_definitions,
+                                    const long long _count, const QString &_token)
+{
+    qCDebug(LOG_DBUS) << "Add" << _count << "tasks" << _definitions.command;
+
+    auto limits = QueuedLimits::Limits(_definitions.limits);
+    QStringList dependencies;
+    for (auto &dependency : _definitions.dependencies)
+        dependencies.append(dependency.toString());
+    QVariantList args = {_definitions.command,
+                         _definitions.arguments,
+                         _definitions.workingDirectory,
+                         _definitions.user,
+                         _definitions.nice,
+                         limits.cpu,
+                         limits.gpu,
+                         limits.memory,
+                         limits.gpumemory,
+                         limits.storage,
+                         _definitions.walltime,
+                         _definitions.gang,
+                         _definitions.startAfter.toString(Qt::ISODateWithMs),
+                         _definitions.deadline.toString(Qt::ISODateWithMs),
+                         dependencies,
+                         _count,
+                         _token};
+    return sendRequest<QList<long long>>(QueuedConfig::DBUS_SERVICE,
+                                         QueuedConfig::DBUS_OBJECT_PATH,
+                                         QueuedConfig::DBUS_SERVICE, "TaskAddArray", args);
+}
+
+
 /**
  * @fn sendTaskEdit
  */
@@ -151,6 +231,7 @@ QueuedCoreAdaptor::sendTaskEdit(const long long _id,
                          limits.memory,
                          limits.gpumemory,
                          limits.storage,
+                         _definitions.walltime,
                          _token};
     return sendRequest<bool>(QueuedConfig::DBUS_SERVICE, QueuedConfig::DBUS_OBJECT_PATH,
                              QueuedConfig::DBUS_SERVICE, "TaskEdit", args);
@@ -256,6 +337,22 @@ QueuedResult<bool> QueuedCoreAdaptor::sendUserPermissionRemove(
 }
 
 
+/**
+ * @fn sendUserQuotaEdit
+ */
+QueuedResult<bool> QueuedCoreAdaptor::sendUserQuotaEdit(const long long _id,
+                                                        const long long _maxTasks,
+                                                        const QueuedLimits::Limits &_quota,
+                                                        const QString &_token)
+{
+    qCDebug(LOG_DBUS) << "Edit quota of user" << _id;
+
+    QVariantList args = {_id, _maxTasks, _quota.cpu, _quota.memory, _token};
+    return sendRequest<bool>(QueuedConfig::DBUS_SERVICE, QueuedConfig::DBUS_OBJECT_PATH,
+                             QueuedConfig::DBUS_SERVICE, "UserQuotaEdit", args);
+}
+
+
 /**
  * @fn getPlugin
  */
@@ -44,6 +44,9 @@ QueuedCoreInterface::QueuedCoreInterface(QueuedCore *parent)
     qRegisterMetaType<QueuedResult<long long>>("QueuedResult<long long>");
     qDBusRegisterMetaType<QueuedResult<long long>>();
 
+    qRegisterMetaType<QueuedResult<QList<long long>>>("QueuedResult<QList<long long>>");
+    qDBusRegisterMetaType<QueuedResult<QList<long long>>>();
+
     qRegisterMetaType<QueuedResult<QString>>("QueuedResult<QString>");
     qDBusRegisterMetaType<QueuedResult<QString>>();
 }
@@ -112,6 +115,34 @@ QDBusVariant QueuedCoreInterface::PluginRemove(const QString &plugin, const QStr
 }
 
 
+/**
+ * @fn ReservationAdd
+ */
+QDBusVariant QueuedCoreInterface::ReservationAdd(const qlonglong user, const qlonglong cpu,
+                                                 const qlonglong memory, const QString &start,
+                                                 const QString &end, const qlonglong period,
+                                                 const QString &token)
+{
+    qCDebug(LOG_DBUS) << "Add reservation for user" << user << "from" << start << "to" << end;
+
+    return QueuedCoreAdaptor::toDBusVariant(m_core->addReservation(
+        user, QueuedLimits::Limits(cpu, 0, memory, 0, 0),
+        QDateTime::fromString(start, Qt::ISODateWithMs),
+        QDateTime::fromString(end, Qt::ISODateWithMs), period, token));
+}
+
+
+/**
+ * @fn ReservationRemove
+ */
+QDBusVariant QueuedCoreInterface::ReservationRemove(const qlonglong id, const QString &token)
+{
+    qCDebug(LOG_DBUS) << "Remove reservation" << id;
+
+    return QueuedCoreAdaptor::toDBusVariant(m_core->removeReservation(id, token));
+}
+
+
 /**
  * @fn TaskAdd
  */
@@ -119,14 +150,42 @@ QDBusVariant QueuedCoreInterface::TaskAdd(const QString &command, const QStringL
                                           const QString &workingDirectory, const qlonglong user,
                                           const uint nice, const qlonglong cpu, const qlonglong gpu,
                                           const qlonglong memory, const qlonglong gpumemory,
-                                          const qlonglong storage, const QString &token)
+                                          const qlonglong storage, const qlonglong walltime,
+                                          const uint gang, const QString &startAfter,
+                                          const QString &deadline,
+                                          const QStringList &dependencies, const QString &token)
 {
     qCDebug(LOG_DBUS) << "Add new task with parameters" << command << arguments << workingDirectory
-                      << "from user" << user;
+                      << "from user" << user << "with dependencies" << dependencies;
 
     return QueuedCoreAdaptor::toDBusVariant(
         m_core->addTask(command, arguments, workingDirectory, user, nice,
-                        QueuedLimits::Limits(cpu, gpu, memory, gpumemory, storage), token));
+                        QueuedLimits::Limits(cpu, gpu, memory, gpumemory, storage), walltime,
+                        gang, QDateTime::fromString(startAfter, Qt::ISODateWithMs),
+                        QDateTime::fromString(deadline, Qt::ISODateWithMs), dependencies, token));
+}
+
+
+/**
+ * @fn TaskAddArray
+ */
+QDBusVariant QueuedCoreInterface::TaskAddArray(
+    const QString &command, const QStringList &arguments, const QString &workingDirectory,
+    const qlonglong user, const uint nice, const qlonglong cpu, const qlonglong gpu,
+    const qlonglong memory, const qlonglong gpumemory, const qlonglong storage,
+    const qlonglong walltime, const uint gang, const QString &startAfter, const QString &deadline,
+    const QStringList &dependencies, const qlonglong count, const QString &token)
+{
+    qCDebug(LOG_DBUS) << "Add" << count << "new tasks with parameters" << command << arguments
+                      << workingDirectory << "from user" << user << "with dependencies"
+                      << dependencies;
+
+    return QueuedCoreAdaptor::toDBusVariant(
+        m_core->addTaskArray(command, arguments, workingDirectory, user, nice,
+                             QueuedLimits::Limits(cpu, gpu, memory, gpumemory, storage), walltime,
+                             gang, QDateTime::fromString(startAfter, Qt::ISODateWithMs),
+                             QDateTime::fromString(deadline, Qt::ISODateWithMs), dependencies,
+                             count, token));
 }
 
 
@@ -139,10 +198,10 @@ QDBusVariant QueuedCoreInterface::TaskEdit(const qlonglong id, const QString &co
                                            const qlonglong user, const qlonglong cpu,
                                            const qlonglong gpu, const qlonglong memory,
                                            const qlonglong gpumemory, const qlonglong storage,
-                                           const QString &token)
+                                           const qlonglong walltime, const QString &token)
 {
     qCDebug(LOG_DBUS) << "Edit task" << id << command << arguments << directory << nice << uid
-                      << gid << cpu << gpu << memory << gpumemory << storage;
+                      << gid << cpu << gpu << memory << gpumemory << storage << walltime;
 
     auto task = m_core->task(id, token);
     if (!task) {
@@ -167,6 +226,8 @@ QDBusVariant QueuedCoreInterface::TaskEdit(const qlonglong id, const QString &co
         data["gid"] = gid;
     if (user > 0)
         data["user"] = user;
+    if (walltime > -1)
+        data["walltime"] = walltime;
     // append limits now
     auto limits = task->nativeLimits();
     if (cpu > -1)
@@ -304,3 +365,35 @@ QDBusVariant QueuedCoreInterface::UserPermissionRemove(const qlonglong id, const
     return QueuedCoreAdaptor::toDBusVariant(m_core->editUserPermission(
         id, static_cast<QueuedEnums::Permission>(permission), false, token));
 }
+
+
+/**
+ * @fn UserQuotaEdit
+ */
+QDBusVariant QueuedCoreInterface::UserQuotaEdit(const qlonglong id, const qlonglong maxTasks,
+                                                const qlonglong cpu, const qlonglong memory,
+                                                const QString &token)
+{
+    qCDebug(LOG_DBUS) << "Edit quota of user" << id << maxTasks << cpu << memory;
+
+    // get user object first to match quota
+    auto user = m_core->user(id, token);
+    if (!user) {
+        qCWarning(LOG_DBUS) << "Could not find user" << id;
+        return QueuedCoreAdaptor::toDBusVariant(QueuedResult<bool>(
+            QueuedError("User does not exist", QueuedEnums::ReturnStatus::InvalidArgument)));
+    }
+
+    // build payload
+    QVariantHash data;
+    if (maxTasks > -1)
+        data["maxTasks"] = maxTasks;
+    auto quota = user->nativeQuota();
+    if (cpu > -1)
+        quota.cpu = cpu;
+    if (memory > -1)
+        quota.memory = memory;
+    data["quota"] = quota.toString();
+
+    return QueuedCoreAdaptor::toDBusVariant(m_core->editUser(id, data, token));
+}
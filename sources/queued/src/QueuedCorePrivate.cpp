@@ -49,6 +49,41 @@ QueuedResult<bool> QueuedCorePrivate::addPlugin(const QString &_plugin, const QS
 }
 
 
+/**
+ * @fn addReservation
+ */
+QueuedResult<long long>
+QueuedCorePrivate::addReservation(const long long _user, const QueuedLimits::Limits &_limits,
+                                  const QDateTime &_start, const QDateTime &_end,
+                                  const long long _period, const QString &_token)
+{
+    qCDebug(LOG_LIB) << "Add reservation for user" << _user << "from" << _start << "to" << _end;
+
+    bool isAdmin = m_users->authorize(_token, QueuedEnums::Permission::Admin);
+    if (!isAdmin) {
+        qCInfo(LOG_LIB) << "User" << _token << "not allowed to add reservation";
+        return QueuedError("Not allowed", QueuedEnums::ReturnStatus::InsufficientPermissions);
+    }
+
+    // check window
+    if (!_start.isValid() || !_end.isValid() || (_end <= _start)) {
+        qCWarning(LOG_LIB) << "Invalid reservation window" << _start << _end;
+        return QueuedError("Invalid window", QueuedEnums::ReturnStatus::InvalidArgument);
+    }
+    if ((_period < 0) || ((_period > 0) && (_period < _start.secsTo(_end)))) {
+        qCWarning(LOG_LIB) << "Reservation period" << _period << "is less than window";
+        return QueuedError("Invalid period", QueuedEnums::ReturnStatus::InvalidArgument);
+    }
+    // check user
+    if ((_user != 0) && !m_users->user(_user)) {
+        qCWarning(LOG_LIB) << "Could not find user" << _user;
+        return QueuedError("Invalid user", QueuedEnums::ReturnStatus::InvalidArgument);
+    }
+
+    return m_helper->addReservationPrivate(_user, _limits, _start, _end, _period);
+}
+
+
 /**
  * @addTask
  */
@@ -57,6 +92,10 @@ QueuedResult<long long> QueuedCorePrivate::addTask(const QString &_command,
                                                    const QString &_workingDirectory,
                                                    const long long _userId, const uint _nice,
                                                    const QueuedLimits::Limits &_limits,
+                                                   const long long _walltime, const uint _gang,
+                                                   const QDateTime &_startAfter,
+                                                   const QDateTime &_deadline,
+                                                   const QStringList &_dependencies,
                                                    const QString &_token)
 {
     qCDebug(LOG_LIB) << "Add task" << _command << "with arguments" << _arguments << "from user"
@@ -88,7 +127,46 @@ QueuedResult<long long> QueuedCorePrivate::addTask(const QString &_command,
     }
 
     return m_helper->addTaskPrivate(_command, _arguments, _workingDirectory, _userId, _nice,
-                                    _limits);
+                                    _limits, _walltime, _gang, _startAfter, _deadline,
+                                    _dependencies);
+}
+
+
+/**
+ * @fn addTaskArray
+ */
+QueuedResult<QList<long long>>
+QueuedCorePrivate::addTaskArray(const QString &_command, const QStringList &_arguments,
+                                const QString &_workingDirectory, const long long _userId,
+                                const uint _nice, const QueuedLimits::Limits &_limits,
+                                const long long _walltime, const uint _gang,
+                                const QDateTime &_startAfter, const QDateTime &_deadline,
+                                const QStringList &_dependencies, const long long _count,
+                                const QString &_token)
+{
+    qCDebug(LOG_LIB) << "Add" << _count << "tasks" << _command << "with arguments" << _arguments
+                     << "from user" << _userId;
+
+    auto authUser = m_users->user(_token, true);
+    if (!authUser) {
+        qCWarning(LOG_LIB) << "Could not find auth user" << _token;
+        return QueuedError("Invalid token", QueuedEnums::ReturnStatus::InvalidToken);
+    }
+    long long userAuthId = authUser->index();
+    long long actualUserId = (_userId == -1) ? userAuthId : _userId;
+
+    // check permissions, same as for single task
+    bool isAllowed = (userAuthId == actualUserId)
+                         ? m_users->authorize(_token, QueuedEnums::Permission::Job)
+                         : m_users->authorize(_token, QueuedEnums::Permission::Admin);
+    if (!isAllowed) {
+        qCInfo(LOG_LIB) << "User" << _token << "not allowed to add task";
+        return QueuedError("Not allowed", QueuedEnums::ReturnStatus::InsufficientPermissions);
+    }
+
+    return m_helper->addTaskArrayPrivate(_command, _arguments, _workingDirectory, actualUserId,
+                                         _nice, _limits, _walltime, _gang, _startAfter,
+                                         _deadline, _dependencies, _count);
 }
 
 
@@ -410,6 +488,33 @@ QueuedResult<bool> QueuedCorePrivate::removePlugin(const QString &_plugin, const
 }
 
 
+/**
+ * @fn removeReservation
+ */
+QueuedResult<bool> QueuedCorePrivate::removeReservation(const long long _id,
+                                                        const QString &_token)
+{
+    qCDebug(LOG_LIB) << "Remove reservation" << _id;
+
+    bool isAdmin = m_users->authorize(_token, QueuedEnums::Permission::Admin);
+    if (!isAdmin) {
+        qCInfo(LOG_LIB) << "User" << _token << "not allowed to remove reservation";
+        return QueuedError("Not allowed", QueuedEnums::ReturnStatus::InsufficientPermissions);
+    }
+
+    return m_helper->removeReservationPrivate(_id);
+}
+
+
+/**
+ * @fn schedulerStatistics
+ */
+QueuedStatusMap QueuedCorePrivate::schedulerStatistics() const
+{
+    return m_processes->statistics();
+}
+
+
 /**
  * @fn startTask
  */
@@ -445,7 +550,8 @@ QueuedResult<bool> QueuedCorePrivate::stopTask(const long long _id, const QStrin
 {
     qCDebug(LOG_LIB) << "Force stop task with ID" << _id;
 
-    auto task = m_processes->process(_id);
+    // only active tasks can be stopped
+    auto task = m_processes->contains(_id) ? m_helper->tryGetTask(_id) : nullptr;
     if (!task) {
         qCWarning(LOG_LIB) << "Could not find task with ID" << _id;
         return QueuedError("Task does not exist", QueuedEnums::ReturnStatus::InvalidArgument);
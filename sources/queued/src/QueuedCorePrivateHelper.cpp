@@ -119,17 +119,61 @@ QVariantHash QueuedCorePrivateHelper::dropAdminFields(const QString &_table,
 
 
 /**
- * @addTaskPrivate
+ * @fn dependenciesPayload
  */
-QueuedResult<long long>
-QueuedCorePrivateHelper::addTaskPrivate(const QString &_command, const QStringList &_arguments,
-                                        const QString &_workingDirectory, const long long _userId,
-                                        const uint _nice, const QueuedLimits::Limits &_limits)
+QueuedResult<QList<QVariantHash>>
+QueuedCorePrivateHelper::dependenciesPayload(const QStringList &_dependencies)
 {
-    qCDebug(LOG_LIB) << "Add task" << _command << "with arguments" << _arguments << "from user"
-                     << _userId;
+    qCDebug(LOG_LIB) << "Get payload for dependencies" << _dependencies;
+
+    QList<QVariantHash> payload;
+    for (auto &dep : _dependencies) {
+        auto dependency = QueuedProcess::QueuedProcessDependency(dep);
+        if (dependency.type == QueuedEnums::DependencyType::Invalid) {
+            qCWarning(LOG_LIB) << "Invalid dependency type" << dep;
+            return QueuedError("Invalid dependency", QueuedEnums::ReturnStatus::InvalidArgument);
+        }
+        // active tasks will be resolved by process manager
+        if (!processes()->contains(dependency.task)) {
+            auto data = database()->get(QueuedDB::TASKS_TABLE, dependency.task);
+            if (data.isEmpty()) {
+                qCWarning(LOG_LIB) << "Could not find dependency" << dependency.task;
+                return QueuedError("Invalid dependency",
+                                   QueuedEnums::ReturnStatus::InvalidArgument);
+            }
+            if ((dependency.type == QueuedEnums::DependencyType::AfterOk)
+                && (data["exitCode"].toInt() != 0)) {
+                qCWarning(LOG_LIB) << "Dependency" << dependency.task << "has failed";
+                return QueuedError("Dependency failed",
+                                   QueuedEnums::ReturnStatus::InvalidArgument);
+            }
+        }
+        payload.append(
+            {{"dependency", dependency.task}, {"type", static_cast<int>(dependency.type)}});
+    }
+
+    return payload;
+}
+
+
+/**
+ * @fn taskPayload
+ */
+QueuedResult<QVariantHash>
+QueuedCorePrivateHelper::taskPayload(const QString &_command, const QStringList &_arguments,
+                                     const QString &_workingDirectory, const long long _userId,
+                                     const uint _nice, const QueuedLimits::Limits &_limits,
+                                     const long long _walltime, const uint _gang,
+                                     const QDateTime &_startAfter, const QDateTime &_deadline)
+{
+    qCDebug(LOG_LIB) << "Get payload for task" << _command << "from user" << _userId;
+
+    // task which may not start before its deadline will never be finished in time
+    if (_startAfter.isValid() && _deadline.isValid() && (_deadline <= _startAfter)) {
+        qCWarning(LOG_LIB) << "Deadline" << _deadline << "is before start" << _startAfter;
+        return QueuedError("Invalid deadline", QueuedEnums::ReturnStatus::InvalidArgument);
+    }
 
-    // add to database
     auto ids = users()->ids(_userId);
     auto userObj = m_core->user(_userId, m_core->m_adminToken);
     if (!userObj) {
@@ -140,22 +184,162 @@ QueuedCorePrivateHelper::addTaskPrivate(const QString &_command, const QStringLi
         _limits, userObj->nativeLimits(),
         QueuedLimits::Limits(
             advancedSettings()->get(QueuedConfig::QueuedSettings::DefaultLimits).toString()));
-    QVariantHash properties = {{"user", _userId},
-                               {"command", _command},
-                               {"commandArguments", _arguments},
-                               {"workDirectory", _workingDirectory},
-                               {"nice", std::min(_nice, userObj->priority())},
-                               {"uid", ids.first},
-                               {"gid", ids.second},
-                               {"limits", taskLimits.toString()}};
-    auto id = database()->add(QueuedDB::TASKS_TABLE, properties);
+
+    return QVariantHash({{"user", _userId},
+                         {"command", _command},
+                         {"commandArguments", _arguments},
+                         {"workDirectory", _workingDirectory},
+                         {"nice", std::min(_nice, userObj->priority())},
+                         {"uid", ids.first},
+                         {"gid", ids.second},
+                         {"limits", taskLimits.toString()},
+                         {"walltime", std::max(_walltime, 0ll)},
+                         // larger gang could never be started
+                         {"gang", std::min(static_cast<long long>(_gang),
+                                           QueuedSystemInfo::cpuCount())},
+                         {"startAfter", _startAfter.toString(Qt::ISODateWithMs)},
+                         {"deadline", _deadline.toString(Qt::ISODateWithMs)}});
+}
+
+
+/**
+ * @fn addReservationPrivate
+ */
+QueuedResult<long long> QueuedCorePrivateHelper::addReservationPrivate(
+    const long long _user, const QueuedLimits::Limits &_limits, const QDateTime &_start,
+    const QDateTime &_end, const long long _period)
+{
+    qCDebug(LOG_LIB) << "Add reservation for user" << _user << "from" << _start << "to" << _end;
+
+    // add to database
+    QVariantHash properties = {{"user", _user},
+                               {"limits", _limits.toString()},
+                               {"startTime", _start.toString(Qt::ISODateWithMs)},
+                               {"endTime", _end.toString(Qt::ISODateWithMs)},
+                               {"period", _period}};
+    auto id = database()->add(QueuedDB::RESERVATIONS_TABLE, properties);
     if (id == -1) {
+        qCWarning(LOG_LIB) << "Could not add reservation for user" << _user;
+        return QueuedError("", QueuedEnums::ReturnStatus::Error);
+    }
+
+    // add to child object and reschedule tasks which were blocked by reservations
+    processes()->addReservation(id, QueuedProcessManager::parseReservation(properties));
+    processes()->start();
+
+    return id;
+}
+
+
+/**
+ * @fn addTaskArrayPrivate
+ */
+QueuedResult<QList<long long>> QueuedCorePrivateHelper::addTaskArrayPrivate(
+    const QString &_command, const QStringList &_arguments, const QString &_workingDirectory,
+    const long long _userId, const uint _nice, const QueuedLimits::Limits &_limits,
+    const long long _walltime, const uint _gang, const QDateTime &_startAfter,
+    const QDateTime &_deadline, const QStringList &_dependencies, const long long _count)
+{
+    qCDebug(LOG_LIB) << "Add" << _count << "tasks" << _command << "with arguments" << _arguments
+                     << "from user" << _userId << "with dependencies" << _dependencies;
+
+    auto maxCount
+        = advancedSettings()->get(QueuedConfig::QueuedSettings::MaxArraySize).toLongLong();
+    if ((_count <= 0) || (_count > maxCount)) {
+        qCWarning(LOG_LIB) << "Invalid array size" << _count << "maximal size" << maxCount;
+        return QueuedError("Invalid array size", QueuedEnums::ReturnStatus::InvalidArgument);
+    }
+
+    // dependencies and user are common for all tasks
+    auto dependencies = dependenciesPayload(_dependencies);
+    if (dependencies.type() != Result::Content::Value)
+        return dependencies.error();
+    auto payload = taskPayload(_command, _arguments, _workingDirectory, _userId, _nice, _limits,
+                               _walltime, _gang, _startAfter, _deadline);
+    if (payload.type() != Result::Content::Value)
+        return payload.error();
+
+    QList<QVariantHash> tasks;
+    for (long long i = 0; i < _count; i++) {
+        auto index = QString::number(i);
+        auto arguments = _arguments;
+        arguments.replaceInStrings(QueuedConfig::ARRAY_INDEX_PLACEHOLDER, index);
+
+        auto properties = payload.get();
+        properties["command"] = QString(_command).replace(QueuedConfig::ARRAY_INDEX_PLACEHOLDER,
+                                                          index);
+        properties["commandArguments"] = arguments;
+        properties["workDirectory"]
+            = QString(_workingDirectory).replace(QueuedConfig::ARRAY_INDEX_PLACEHOLDER, index);
+        tasks.append(properties);
+    }
+
+    // add to database together with dependencies
+    auto ids = database()->addTasks(tasks, dependencies.get());
+    if (ids.count() != tasks.count()) {
+        qCWarning(LOG_LIB) << "Could not add tasks" << _command;
+        return QueuedError("", QueuedEnums::ReturnStatus::Error);
+    }
+
+    QMap<long long, QueuedProcess::QueuedProcessDefinitions> definitions;
+    for (int i = 0; i < ids.count(); i++) {
+        auto deps = dependencies.get();
+        for (auto &dependency : deps)
+            dependency["task"] = ids.at(i);
+        definitions[ids.at(i)] = processes()->parseDefinitions(tasks.at(i), QList<QVariantHash>(),
+                                                                deps);
+    }
+
+    // add to child object
+    processes()->add(definitions);
+    // notify plugins
+    if (plugins()) {
+        for (auto id : ids)
+            emit(plugins()->interface()->onAddTask(id));
+    }
+
+    return ids;
+}
+
+
+/**
+ * @addTaskPrivate
+ */
+QueuedResult<long long>
+QueuedCorePrivateHelper::addTaskPrivate(const QString &_command, const QStringList &_arguments,
+                                        const QString &_workingDirectory, const long long _userId,
+                                        const uint _nice, const QueuedLimits::Limits &_limits,
+                                        const long long _walltime, const uint _gang,
+                                        const QDateTime &_startAfter, const QDateTime &_deadline,
+                                        const QStringList &_dependencies)
+{
+    qCDebug(LOG_LIB) << "Add task" << _command << "with arguments" << _arguments << "from user"
+                     << _userId << "with dependencies" << _dependencies;
+
+    // check dependencies first
+    auto dependencies = dependenciesPayload(_dependencies);
+    if (dependencies.type() != Result::Content::Value)
+        return dependencies.error();
+
+    // add to database
+    auto payload = taskPayload(_command, _arguments, _workingDirectory, _userId, _nice, _limits,
+                               _walltime, _gang, _startAfter, _deadline);
+    if (payload.type() != Result::Content::Value)
+        return payload.error();
+    auto properties = payload.get();
+    auto ids = database()->addTasks({properties}, dependencies.get());
+    if (ids.isEmpty()) {
         qCWarning(LOG_LIB) << "Could not add task" << _command;
         return QueuedError("", QueuedEnums::ReturnStatus::Error);
     }
+    auto id = ids.first();
+
+    auto deps = dependencies.get();
+    for (auto &dependency : deps)
+        dependency["task"] = id;
 
     // add to child object
-    processes()->add(properties, QList<QVariantHash>(), id);
+    processes()->add(properties, QList<QVariantHash>(), id, deps);
     // notify plugins
     if (plugins())
         emit(plugins()->interface()->onAddTask(id));
@@ -306,6 +490,8 @@ QueuedResult<bool> QueuedCorePrivateHelper::editTaskPrivate(QueuedProcess *_proc
     // modify values stored in memory
     for (auto &property : _taskData.keys())
         _process->setProperty(qPrintable(property), _taskData[property]);
+    // update pending task if required
+    processes()->update(_process->index(), _process->definitions());
     // notify plugins
     if (plugins())
         emit(plugins()->interface()->onEditTask(_process->index(), _taskData));
@@ -333,6 +519,11 @@ QueuedResult<bool> QueuedCorePrivateHelper::editUserPrivate(QueuedUser *_user,
     // modify values stored in memory
     for (auto &property : _userData.keys())
         _user->setProperty(qPrintable(property), _userData[property]);
+    // scheduler keeps its own copy of quota
+    if (_userData.contains("maxTasks") || _userData.contains("quota")) {
+        processes()->setQuota(_user->index(), _user->maxTasks(), _user->nativeQuota());
+        processes()->start();
+    }
     // notify plugins
     if (plugins())
         emit(plugins()->interface()->onEditUser(_user->index(), _userData));
@@ -380,6 +571,25 @@ QueuedResult<bool> QueuedCorePrivateHelper::editUserPermissionPrivate(
 }
 
 
+/**
+ * @fn removeReservationPrivate
+ */
+QueuedResult<bool> QueuedCorePrivateHelper::removeReservationPrivate(const long long _id)
+{
+    qCDebug(LOG_LIB) << "Remove reservation" << _id;
+
+    if (!database()->remove(QueuedDB::RESERVATIONS_TABLE, _id)) {
+        qCWarning(LOG_LIB) << "Could not remove reservation" << _id;
+        return QueuedError("", QueuedEnums::ReturnStatus::Error);
+    }
+
+    processes()->removeReservation(_id);
+    processes()->start();
+
+    return true;
+}
+
+
 /**
  * @fn tryGetTask
  */
@@ -388,20 +598,30 @@ QueuedProcess *QueuedCorePrivateHelper::tryGetTask(const long long _id)
     qCDebug(LOG_LIB) << "Search for task" << _id;
 
     auto task = processes()->process(_id);
-    if (!task) {
-        qCInfo(LOG_LIB) << "Try to get information about task" << _id << "from database";
-        auto data = database()->get(QueuedDB::TASKS_TABLE, _id);
-        if (data.isEmpty()) {
-            qCWarning(LOG_LIB) << "Could not find task with ID" << _id;
-            return nullptr;
-        }
-        qCInfo(LOG_LIB) << "Try to get task" << _id << "modifications from database";
-        auto mods
-            = database()->get(QueuedDB::TASKS_MODS_TABLE, "WHERE task=:task", {{"task", _id}});
+    if (task)
+        return task;
+
+    // pending tasks do not have process objects, thus temporary one is created, it is used by
+    // callers synchronously and will be removed on the next event loop iteration
+    auto pending = processes()->pendingTask(_id);
+    if (pending) {
+        task = new QueuedProcess(this, pending->definitions, _id);
+        task->deleteLater();
+        return task;
+    }
 
-        auto defs = QueuedProcessManager::parseDefinitions(data, mods);
-        task = new QueuedProcess(this, defs, _id);
+    qCInfo(LOG_LIB) << "Try to get information about task" << _id << "from database";
+    auto data = database()->get(QueuedDB::TASKS_TABLE, _id);
+    if (data.isEmpty()) {
+        qCWarning(LOG_LIB) << "Could not find task with ID" << _id;
+        return nullptr;
     }
+    qCInfo(LOG_LIB) << "Try to get task" << _id << "modifications from database";
+    auto mods = database()->get(QueuedDB::TASKS_MODS_TABLE, "WHERE task=:task", {{"task", _id}});
+
+    auto defs = QueuedProcessManager::parseDefinitions(data, mods);
+    task = new QueuedProcess(this, defs, _id);
+    task->deleteLater();
 
     return task;
 }
@@ -84,8 +84,9 @@ void QueuedCorePrivate::init(const QString &_configuration)
     m_adminToken = m_users->authorize(m_settings->admin().name);
 
     initPlugins();
-    initProcesses();
+    // reports are used to restore resource usage of users
     initReports();
+    initProcesses();
 
     // settings update notifier
     m_connections += connect(
@@ -129,24 +130,84 @@ void QueuedCorePrivate::initProcesses()
     auto onExitAction = static_cast<QueuedEnums::ExitAction>(
         m_advancedSettings->get(QueuedConfig::QueuedSettings::OnExitAction).toInt());
 
+    // groups of tasks and pool could be created only after hierarchy has been prepared
+    if (!QueuedControlGroupsAdaptor::prepareHierarchy())
+        qCWarning(LOG_LIB) << "Could not prepare control groups, limits might not be applied";
+
     m_processes = m_helper->initObject(m_processes);
     m_processes->setExitAction(onExitAction);
+    m_processes->setPolicy(QueuedEnums::stringToSchedulerPolicy(
+        m_advancedSettings->get(QueuedConfig::QueuedSettings::SchedulerPolicy).toString()));
+    m_processes->setPreemption(QueuedEnums::stringToPreemptionMode(
+        m_advancedSettings->get(QueuedConfig::QueuedSettings::Preemption).toString()));
+    m_processes->setFairShareHalfLife(
+        m_advancedSettings->get(QueuedConfig::QueuedSettings::FairShareHalfLife).toLongLong());
+    m_processes->setAdmissionHysteresis(
+        m_advancedSettings->get(QueuedConfig::QueuedSettings::AdmissionHysteresis).toLongLong());
+    m_processes->setAdmissionMargin(
+        m_advancedSettings->get(QueuedConfig::QueuedSettings::AdmissionMargin).toLongLong());
+    m_processes->setAdmissionInterval(
+        m_advancedSettings->get(QueuedConfig::QueuedSettings::AdmissionInterval).toLongLong());
+    m_processes->setCpuPinning(
+        m_advancedSettings->get(QueuedConfig::QueuedSettings::CpuPinning).toBool());
+    m_processes->setGroupPool(
+        m_advancedSettings->get(QueuedConfig::QueuedSettings::GroupPool).toLongLong());
+    m_processes->setUsageInterval(
+        m_advancedSettings->get(QueuedConfig::QueuedSettings::UsageInterval).toLongLong());
+    // restore usage, older tasks have negligible weight
+    auto halfLife = m_processes->fairShareHalfLife();
+    auto usageTasks = m_reports->tasks(-1, QDateTime::currentDateTimeUtc().addSecs(-10 * halfLife));
+    for (auto &task : usageTasks) {
+        // cancelled tasks have end time, but have never been started
+        auto startTime = QDateTime::fromString(task["startTime"].toString(), Qt::ISODateWithMs);
+        auto endTime = QDateTime::fromString(task["endTime"].toString(), Qt::ISODateWithMs);
+        if (!startTime.isValid() || !endTime.isValid())
+            continue;
+        m_processes->addUsage(task["user"].toLongLong(), QueuedReportManager::usage(task),
+                              endTime);
+    }
+    // quotas must be known before tasks are started
+    for (auto &user : m_database->get(QueuedDB::USERS_TABLE)) {
+        auto definitions = QueuedUserManager::parseDefinitions(user);
+        m_processes->setQuota(user["_id"].toLongLong(), definitions.maxTasks,
+                              QueuedLimits::Limits(definitions.quota));
+    }
+    for (auto &reservation : m_database->get(QueuedDB::RESERVATIONS_TABLE))
+        m_processes->addReservation(reservation["_id"].toLongLong(),
+                                    QueuedProcessManager::parseReservation(reservation));
     auto dbProcesses = m_database->get(QueuedDB::TASKS_TABLE, "WHERE endTime IS NULL");
+    // map is ordered by ID, thus dependencies are added before dependent tasks
+    QMap<long long, QueuedProcess::QueuedProcessDefinitions> definitions;
     for (auto &proc : dbProcesses) {
         auto _id = proc["_id"].toLongLong();
         auto mods
             = m_database->get(QueuedDB::TASKS_MODS_TABLE, "WHERE task=:task", {{"task", _id}});
-        m_processes->add(proc, mods, _id);
+        auto deps
+            = m_database->get(QueuedDB::TASKS_DEPS_TABLE, "WHERE task=:task", {{"task", _id}});
+        definitions[_id] = QueuedProcessManager::parseDefinitions(proc, mods, deps);
     }
+    m_processes->add(definitions);
 
     m_connections += connect(m_processes, &QueuedProcessManager::taskStartTimeReceived,
                              [this](const long long _index, const QDateTime &_time) {
                                  return updateTaskTime(_index, _time, QDateTime());
                              });
+    m_connections += connect(
+        m_processes, &QueuedProcessManager::taskExitCodeReceived,
+        [this](const long long _index, const int _exitCode, const QueuedEnums::ExitReason _reason) {
+            return updateTaskExitCode(_index, _exitCode, _reason);
+        });
+    m_connections += connect(m_processes, &QueuedProcessManager::taskRequeued,
+                             [this](const long long _index) { return updateTaskRequeued(_index); });
     m_connections += connect(m_processes, &QueuedProcessManager::taskStopTimeReceived,
                              [this](const long long _index, const QDateTime &_time) {
                                  return updateTaskTime(_index, QDateTime(), _time);
                              });
+    m_connections += connect(m_processes, &QueuedProcessManager::taskUsageReceived,
+                             [this](const long long _index, const long long _cpuTime,
+                                    const long long _memoryPeak, const long long _ioBytes) {
+                                 return updateTaskUsage(_index, _cpuTime, _memoryPeak, _ioBytes);
+                             });
 }
 
 
@@ -28,6 +28,8 @@
 
 #include <queued/private/QueuedCorePrivateHelper.h>
 
+#include <algorithm>
+
 
 /**
  * @class QueuedCorePrivate
@@ -49,6 +51,21 @@ void QueuedCorePrivate::updateSettings(const QueuedConfig::QueuedSettings _id, c
             m_plugins->optionChanged(_key, _value);
         // do nothing otherwise
         break;
+    case QueuedConfig::QueuedSettings::AdmissionHysteresis:
+        m_processes->setAdmissionHysteresis(_value.toLongLong());
+        break;
+    case QueuedConfig::QueuedSettings::AdmissionInterval:
+        m_processes->setAdmissionInterval(_value.toLongLong());
+        // tasks might be admitted by other rules now
+        m_processes->start();
+        break;
+    case QueuedConfig::QueuedSettings::AdmissionMargin:
+        m_processes->setAdmissionMargin(_value.toLongLong());
+        m_processes->start();
+        break;
+    case QueuedConfig::QueuedSettings::CpuPinning:
+        m_processes->setCpuPinning(_value.toBool());
+        break;
     case QueuedConfig::QueuedSettings::DatabaseInterval:
         m_databaseManager->setInterval(_value.toLongLong());
         break;
@@ -56,18 +73,35 @@ void QueuedCorePrivate::updateSettings(const QueuedConfig::QueuedSettings _id, c
         break;
     case QueuedConfig::QueuedSettings::DefaultLimits:
         break;
+    case QueuedConfig::QueuedSettings::FairShareHalfLife:
+        m_processes->setFairShareHalfLife(_value.toLongLong());
+        break;
+    case QueuedConfig::QueuedSettings::GroupPool:
+        m_processes->setGroupPool(_value.toLongLong());
+        break;
     case QueuedConfig::QueuedSettings::KeepTasks:
         m_databaseManager->setKeepTasks(_value.toLongLong());
         break;
     case QueuedConfig::QueuedSettings::KeepUsers:
         m_databaseManager->setKeepUsers(_value.toLongLong());
         break;
+    case QueuedConfig::QueuedSettings::MaxArraySize:
+        break;
     case QueuedConfig::QueuedSettings::OnExitAction:
         m_processes->setExitAction(static_cast<QueuedEnums::ExitAction>(_value.toInt()));
         break;
     case QueuedConfig::QueuedSettings::Plugins:
         // do nothing here
         break;
+    case QueuedConfig::QueuedSettings::Preemption:
+        m_processes->setPreemption(QueuedEnums::stringToPreemptionMode(_value.toString()));
+        m_processes->start();
+        break;
+    case QueuedConfig::QueuedSettings::SchedulerPolicy:
+        m_processes->setPolicy(QueuedEnums::stringToSchedulerPolicy(_value.toString()));
+        // new policy might allow to start more tasks
+        m_processes->start();
+        break;
     case QueuedConfig::QueuedSettings::ServerAddress:
     case QueuedConfig::QueuedSettings::ServerMaxConnections:
     case QueuedConfig::QueuedSettings::ServerPort:
@@ -77,10 +111,46 @@ void QueuedCorePrivate::updateSettings(const QueuedConfig::QueuedSettings _id, c
     case QueuedConfig::QueuedSettings::TokenExpiration:
         m_users->setTokenExpiration(_value.toLongLong());
         break;
+    case QueuedConfig::QueuedSettings::UsageInterval:
+        m_processes->setUsageInterval(_value.toLongLong());
+        break;
     }
 }
 
 
+/**
+ * @fn updateTaskExitCode
+ */
+void QueuedCorePrivate::updateTaskExitCode(const long long _id, const int _exitCode,
+                                           const QueuedEnums::ExitReason _reason)
+{
+    qCDebug(LOG_LIB) << "Update task" << _id << "exit code to" << _exitCode << "with reason"
+                     << static_cast<int>(_reason);
+
+    QVariantHash record = {{"exitCode", _exitCode}, {"exitReason", static_cast<int>(_reason)}};
+
+    bool status = m_database->modify(QueuedDB::TASKS_TABLE, _id, record);
+    if (!status)
+        qCWarning(LOG_LIB) << "Could not modify task record" << _id;
+}
+
+
+/**
+ * @fn updateTaskRequeued
+ */
+void QueuedCorePrivate::updateTaskRequeued(const long long _id)
+{
+    qCDebug(LOG_LIB) << "Reset start time of requeued task" << _id;
+
+    // task is pending again, thus it is shown as not started
+    QVariantHash record = {{"startTime", QVariant()}};
+
+    bool status = m_database->modify(QueuedDB::TASKS_TABLE, _id, record);
+    if (!status)
+        qCWarning(LOG_LIB) << "Could not modify task record" << _id;
+}
+
+
 /**
  * @fn updateTaskTime
  */
@@ -107,6 +177,28 @@ void QueuedCorePrivate::updateTaskTime(const long long _id, const QDateTime &_st
 }
 
 
+/**
+ * @fn updateTaskUsage
+ */
+void QueuedCorePrivate::updateTaskUsage(const long long _id, const long long _cpuTime,
+                                        const long long _memoryPeak, const long long _ioBytes)
+{
+    qCDebug(LOG_LIB) << "Update task" << _id << "usage to" << _cpuTime << _memoryPeak
+                     << _ioBytes;
+
+    // requeued task might have been run before
+    auto task = m_database->get(QueuedDB::TASKS_TABLE, _id);
+    QVariantHash record
+        = {{"cpuTime", task["cpuTime"].toLongLong() + _cpuTime},
+           {"memoryPeak", std::max(task["memoryPeak"].toLongLong(), _memoryPeak)},
+           {"ioBytes", task["ioBytes"].toLongLong() + _ioBytes}};
+
+    bool status = m_database->modify(QueuedDB::TASKS_TABLE, _id, record);
+    if (!status)
+        qCWarning(LOG_LIB) << "Could not modify task record" << _id;
+}
+
+
 /**
  * @fn updateUserLoginTime
  */
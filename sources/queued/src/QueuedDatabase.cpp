@@ -269,6 +269,75 @@ long long QueuedDatabase::add(const QString &_table, const QVariantHash &_value)
 }
 
 
+/**
+ * @fn add
+ */
+QList<long long> QueuedDatabase::add(const QString &_table, const QList<QVariantHash> &_values)
+{
+    qCDebug(LOG_LIB) << "Add" << _values.count() << "records to table" << _table;
+
+    if (!m_database.transaction()) {
+        qCWarning(LOG_LIB) << "Could not start transaction" << m_database.lastError().text();
+        return QList<long long>();
+    }
+
+    auto output = insert(_table, _values);
+    if (output.count() != _values.count()) {
+        m_database.rollback();
+        return QList<long long>();
+    }
+
+    if (!m_database.commit()) {
+        qCWarning(LOG_LIB) << "Could not commit transaction" << m_database.lastError().text();
+        m_database.rollback();
+        return QList<long long>();
+    }
+
+    return output;
+}
+
+
+/**
+ * @fn addTasks
+ */
+QList<long long> QueuedDatabase::addTasks(const QList<QVariantHash> &_tasks,
+                                          const QList<QVariantHash> &_dependencies)
+{
+    qCDebug(LOG_LIB) << "Add" << _tasks.count() << "tasks with dependencies" << _dependencies;
+
+    if (!m_database.transaction()) {
+        qCWarning(LOG_LIB) << "Could not start transaction" << m_database.lastError().text();
+        return QList<long long>();
+    }
+
+    auto output = insert(QueuedDB::TASKS_TABLE, _tasks);
+    if (output.count() != _tasks.count()) {
+        m_database.rollback();
+        return QList<long long>();
+    }
+    // tasks without dependencies must not be left if dependencies could not be added
+    QList<QVariantHash> dependencies;
+    for (auto id : output) {
+        for (auto dependency : _dependencies) {
+            dependency["task"] = id;
+            dependencies.append(dependency);
+        }
+    }
+    if (insert(QueuedDB::TASKS_DEPS_TABLE, dependencies).count() != dependencies.count()) {
+        m_database.rollback();
+        return QList<long long>();
+    }
+
+    if (!m_database.commit()) {
+        qCWarning(LOG_LIB) << "Could not commit transaction" << m_database.lastError().text();
+        m_database.rollback();
+        return QList<long long>();
+    }
+
+    return output;
+}
+
+
 /**
  * @fn modify
  */
@@ -378,6 +447,43 @@ QStringList QueuedDatabase::getColumnsInRecord(const QSqlRecord &_record) const
 }
 
 
+/**
+ * @fn insert
+ */
+QList<long long> QueuedDatabase::insert(const QString &_table, const QList<QVariantHash> &_values)
+{
+    QList<long long> output;
+    QString queryString;
+    QSqlQuery query(m_database);
+    for (auto &value : _values) {
+        auto payload = getQueryPayload(_table, value);
+        auto currentQuery = QString("INSERT INTO %1 (%2) VALUES (%3)")
+                                .arg(_table)
+                                .arg(payload.keys().join(','))
+                                .arg(payload.values().join(','));
+        // records usually share the same columns, thus query is prepared only once
+        if (currentQuery != queryString) {
+            queryString = currentQuery;
+            query.prepare(queryString);
+        }
+        for (auto &key : payload.keys())
+            query.bindValue(payload[key], value[key]);
+        query.exec();
+
+        auto error = query.lastError();
+        if (error.isValid()) {
+            qCWarning(LOG_LIB) << "Could not add records using query" << queryString << "message"
+                               << error.text();
+            return QList<long long>();
+        }
+        auto id = query.lastInsertId();
+        output.append(id.isValid() ? id.toLongLong() : lastInsertionId(_table));
+    }
+
+    return output;
+}
+
+
 /**
  * @fn lastInsertionId
  */
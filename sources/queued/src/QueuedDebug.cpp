@@ -31,6 +31,7 @@ Q_LOGGING_CATEGORY(LOG_CTL, "org.queued.control", QtMsgType::QtWarningMsg)
 Q_LOGGING_CATEGORY(LOG_DBUS, "org.queued.dbus", QtMsgType::QtWarningMsg)
 Q_LOGGING_CATEGORY(LOG_LIB, "org.queued.library", QtMsgType::QtWarningMsg)
 Q_LOGGING_CATEGORY(LOG_PL, "org.queued.plugin", QtMsgType::QtWarningMsg)
+Q_LOGGING_CATEGORY(LOG_SCHED, "org.queued.scheduler", QtMsgType::QtWarningMsg)
 Q_LOGGING_CATEGORY(LOG_SERV, "org.queued.server", QtMsgType::QtWarningMsg)
 
 
@@ -139,6 +140,7 @@ QHash<QString, QHash<QString, QString>> QueuedDebug::getBuildMetaData()
              {
                  {"BUILD_DEB_PACKAGE", BUILD_DEB_PACKAGE},
                  {"BUILD_RPM_PACKAGE", BUILD_RPM_PACKAGE},
+                 {"BUILD_SIMULATOR", BUILD_SIMULATOR},
                  {"CLANGFORMAT_EXECUTABLE", CLANGFORMAT_EXECUTABLE},
                  {"COVERITY_COMMENT", COVERITY_COMMENT},
                  {"COVERITY_DIRECTORY", COVERITY_DIRECTORY},
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2017 Queued team
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ *
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+/**
+ * @file QueuedHistogram.cpp
+ * Source code of queued library
+ * @author Queued team
+ * @copyright MIT
+ * @bug https://github.com/arcan1s/queued/issues
+ */
+
+
+#include <queued/Queued.h>
+
+#include <cmath>
+
+
+/**
+ * @fn count
+ */
+long long QueuedHistogram::count() const
+{
+    return m_count;
+}
+
+
+/**
+ * @fn max
+ */
+long long QueuedHistogram::max() const
+{
+    return m_max;
+}
+
+
+/**
+ * @fn mean
+ */
+double QueuedHistogram::mean() const
+{
+    return (m_count > 0) ? m_sum / m_count : 0.0;
+}
+
+
+/**
+ * @fn min
+ */
+long long QueuedHistogram::min() const
+{
+    return m_min;
+}
+
+
+/**
+ * @fn percentile
+ */
+long long QueuedHistogram::percentile(const double _percentile) const
+{
+    if (m_count == 0)
+        return 0;
+
+    auto target = static_cast<long long>(std::ceil(_percentile / 100.0 * m_count));
+    target = std::max(std::min(target, m_count), 1ll);
+    long long cumulative = 0;
+    for (int i = 0; i < m_buckets.count(); i++) {
+        cumulative += m_buckets.at(i);
+        if (cumulative >= target)
+            return std::min(bucketMax(i), m_max);
+    }
+
+    return m_max;
+}
+
+
+/**
+ * @fn record
+ */
+void QueuedHistogram::record(const long long _value)
+{
+    auto value = std::max(_value, 0ll);
+
+    auto index = bucket(value);
+    if (index >= m_buckets.count())
+        m_buckets.resize(index + 1);
+    m_buckets[index]++;
+
+    m_min = (m_count == 0) ? value : std::min(m_min, value);
+    m_max = std::max(m_max, value);
+    m_sum += value;
+    m_count++;
+}
+
+
+/**
+ * @fn summary
+ */
+QHash<QString, QString> QueuedHistogram::summary() const
+{
+    return {
+        {"count", QString::number(count())},
+        {"min", QString::number(min())},
+        {"mean", QString::number(mean(), 'f', 1)},
+        {"max", QString::number(max())},
+        {"p50", QString::number(percentile(50.0))},
+        {"p90", QString::number(percentile(90.0))},
+        {"p99", QString::number(percentile(99.0))},
+        {"p999", QString::number(percentile(99.9))},
+    };
+}
+
+
+/**
+ * @fn bucket
+ */
+int QueuedHistogram::bucket(const long long _value)
+{
+    // small values are stored as is
+    if (_value < SUB_BUCKETS)
+        return static_cast<int>(_value);
+
+    // SUB_BUCKETS is power of two, thus the shift keeps the leading bits of value only
+    auto shift = static_cast<int>(std::log2(_value)) - static_cast<int>(std::log2(SUB_BUCKETS));
+    while ((_value >> shift) >= 2 * SUB_BUCKETS)
+        shift++;
+    while ((shift > 0) && ((_value >> shift) < SUB_BUCKETS))
+        shift--;
+
+    return static_cast<int>(SUB_BUCKETS * (shift + 1) + (_value >> shift) - SUB_BUCKETS);
+}
+
+
+/**
+ * @fn bucketMax
+ */
+long long QueuedHistogram::bucketMax(const int _bucket)
+{
+    if (_bucket < SUB_BUCKETS)
+        return _bucket;
+
+    auto shift = _bucket / SUB_BUCKETS - 1;
+    auto leading = static_cast<long long>(_bucket % SUB_BUCKETS + SUB_BUCKETS);
+
+    return ((leading + 1) << shift) - 1;
+}
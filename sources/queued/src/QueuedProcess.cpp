@@ -27,6 +27,7 @@
 #include <QMetaProperty>
 #include <QStandardPaths>
 
+#include <algorithm>
 #include <cmath>
 #include <csignal>
 
@@ -46,6 +47,7 @@ QueuedProcess::QueuedProcess(QObject *_parent, const QueuedProcessDefinitions &d
     : QProcess(_parent)
     , m_definitions(definitions)
     , m_index(index)
+    , m_nativeLimits(definitions.limits)
 {
     qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
 
@@ -88,11 +90,107 @@ void QueuedProcess::killChildren()
 }
 
 
+/**
+ * @fn launch
+ */
+void QueuedProcess::launch()
+{
+    qCDebug(LOG_LIB) << "Launch process" << name();
+
+    // configure cgroup in parent, forked child should do as little as possible
+    if (!m_groupCreated)
+        m_groupCreated = m_cgroup->createGroup();
+    auto nl = nativeLimits();
+    // limit which covers the whole system is not applied
+    m_cgroup->setCpuLimit((QueuedSystemInfo::cpuWeight(nl.cpu) < 1.0) ? nl.cpu : 0);
+    m_cgroup->setMemoryLimit(
+        std::llround(QueuedSystemInfo::memoryWeight(nl.memory) * QueuedSystemInfo::memoryCount()));
+    if (!m_cpuSet.isEmpty())
+        m_cgroup->setCpuSet(m_cpuSet);
+    if (!m_memorySet.isEmpty())
+        m_cgroup->setMemorySet(m_memorySet);
+    m_procFiles = m_cgroup->processFiles();
+    m_groupJoined = !m_procFiles.isEmpty();
+
+    start();
+}
+
+
+/**
+ * @fn resume
+ */
+void QueuedProcess::resume()
+{
+    qCInfo(LOG_LIB) << "Resume process" << index();
+
+    // signal to pid 0 would be sent to the whole process group
+    if (pid() <= 0)
+        return;
+    for (auto pid : childrenPids())
+        ::kill(pid, SIGCONT);
+    ::kill(pid(), SIGCONT);
+}
+
+
+/**
+ * @fn sampleUsage
+ */
+void QueuedProcess::sampleUsage(const QDateTime &_time)
+{
+    qCDebug(LOG_LIB) << "Sample usage of process" << name() << "at" << _time;
+
+    // process has not been started in its own group
+    if (!m_groupCreated)
+        return;
+
+    auto cpuTime = std::max(m_cgroup->cpuUsage(), m_cpuTime);
+    auto ioBytes = std::max(m_cgroup->ioUsage(), m_ioBytes);
+    m_memoryPeak = std::max(m_cgroup->memoryPeak(), m_memoryPeak);
+    m_oomKills = std::max(m_cgroup->oomKills(), m_oomKills);
+    // the first sample is used as base for rates only
+    auto elapsed = m_usageTime.isValid() ? m_usageTime.msecsTo(_time) : 0;
+    if (elapsed > 0) {
+        QueuedUsageHistory::QueuedUsagePoint point;
+        point.time = _time.toMSecsSinceEpoch();
+        point.cpu = static_cast<double>(cpuTime - m_cpuTime) / (elapsed * 1000000.0);
+        point.memory = m_cgroup->memoryUsage();
+        point.memoryPeak = m_memoryPeak;
+        point.io = (ioBytes - m_ioBytes) * 1000 / elapsed;
+        point.pids = m_cgroup->pidsCount();
+        m_usage.append(point);
+    }
+
+    m_cpuTime = cpuTime;
+    m_ioBytes = ioBytes;
+    m_usageTime = _time;
+}
+
+
+/**
+ * @fn suspend
+ */
+void QueuedProcess::suspend()
+{
+    qCInfo(LOG_LIB) << "Suspend process" << index();
+
+    if (pid() <= 0)
+        return;
+    // parent is stopped first, thus it could not spawn new children
+    ::kill(pid(), SIGSTOP);
+    for (auto pid : childrenPids())
+        ::kill(pid, SIGSTOP);
+}
+
+
 /**
  * @fn childrenPids
  */
 QList<Q_PID> QueuedProcess::childrenPids() const
 {
+    // process which is not running has no children, but pid 0 is parent of system ones
+    if (pid() <= 0)
+        return {};
+
     QStringList allDirectories
         = QDir("/proc").entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
     QStringList directories = allDirectories.filter(QRegExp("(\\d+)"));
@@ -119,6 +217,33 @@ QList<Q_PID> QueuedProcess::childrenPids() const
 }
 
 
+/**
+ * @fn cgroup
+ */
+QueuedControlGroupsAdaptor *QueuedProcess::cgroup() const
+{
+    return m_cgroup;
+}
+
+
+/**
+ * @fn cpuTime
+ */
+long long QueuedProcess::cpuTime() const
+{
+    return m_cpuTime / 1000000;
+}
+
+
+/**
+ * @fn definitions
+ */
+const QueuedProcess::QueuedProcessDefinitions &QueuedProcess::definitions() const
+{
+    return m_definitions;
+}
+
+
 /**
  * @fn index
  */
@@ -128,6 +253,24 @@ long long QueuedProcess::index() const
 }
 
 
+/**
+ * @fn ioBytes
+ */
+long long QueuedProcess::ioBytes() const
+{
+    return m_ioBytes;
+}
+
+
+/**
+ * @fn memoryPeak
+ */
+long long QueuedProcess::memoryPeak() const
+{
+    return m_memoryPeak;
+}
+
+
 /**
  * @fn name
  */
@@ -137,6 +280,51 @@ QString QueuedProcess::name() const
 }
 
 
+/**
+ * @fn nativeUsage
+ */
+QueuedUsageHistory::QueuedUsagePoint QueuedProcess::nativeUsage() const
+{
+    return m_usage.last();
+}
+
+
+/**
+ * @fn oomKills
+ */
+long long QueuedProcess::oomKills() const
+{
+    return m_oomKills;
+}
+
+
+/**
+ * @fn usage
+ */
+QString QueuedProcess::usage() const
+{
+    return (m_usage.count() > 0) ? QueuedUsageHistory::toString(m_usage.last()) : QString();
+}
+
+
+/**
+ * @fn usageHistory
+ */
+QStringList QueuedProcess::usageHistory() const
+{
+    return m_usage.toStringList();
+}
+
+
+/**
+ * @fn deadline
+ */
+QDateTime QueuedProcess::deadline() const
+{
+    return m_definitions.deadline;
+}
+
+
 /**
  * @fn endTime
  */
@@ -146,6 +334,15 @@ QDateTime QueuedProcess::endTime() const
 }
 
 
+/**
+ * @fn gang
+ */
+uint QueuedProcess::gang() const
+{
+    return m_definitions.gang;
+}
+
+
 /**
  * @fn gid
  */
@@ -160,7 +357,7 @@ uint QueuedProcess::gid() const
  */
 QString QueuedProcess::limits() const
 {
-    return m_definitions.limits;
+    return m_nativeLimits.toString();
 }
 
 
@@ -187,7 +384,7 @@ QString QueuedProcess::logOutput() const
  */
 QueuedLimits::Limits QueuedProcess::nativeLimits() const
 {
-    return QueuedLimits::Limits(limits());
+    return m_nativeLimits;
 }
 
 
@@ -200,6 +397,15 @@ uint QueuedProcess::nice() const
 }
 
 
+/**
+ * @fn startAfter
+ */
+QDateTime QueuedProcess::startAfter() const
+{
+    return m_definitions.startAfter;
+}
+
+
 /**
  * @fn startTime
  */
@@ -227,6 +433,15 @@ long long QueuedProcess::user() const
 }
 
 
+/**
+ * @fn walltime
+ */
+long long QueuedProcess::walltime() const
+{
+    return m_definitions.walltime;
+}
+
+
 /**
  * @fn workDirectory
  */
@@ -236,6 +451,17 @@ QString QueuedProcess::workDirectory() const
 }
 
 
+/**
+ * @fn setDeadline
+ */
+void QueuedProcess::setDeadline(const QDateTime &_time)
+{
+    qCDebug(LOG_LIB) << "Set deadline to" << _time;
+
+    m_definitions.deadline = _time;
+}
+
+
 /**
  * @fn setEndTime
  */
@@ -266,6 +492,7 @@ void QueuedProcess::setLimits(const QString &_limits)
     qCDebug(LOG_LIB) << "Set process limits" << _limits;
 
     m_definitions.limits = _limits;
+    m_nativeLimits = QueuedLimits::Limits(_limits);
 }
 
 
@@ -298,6 +525,17 @@ void QueuedProcess::setNice(const uint _nice)
 }
 
 
+/**
+ * @fn setStartAfter
+ */
+void QueuedProcess::setStartAfter(const QDateTime &_time)
+{
+    qCDebug(LOG_LIB) << "Set earliest start time to" << _time;
+
+    m_definitions.startAfter = _time;
+}
+
+
 /**
  * @fn setStartTime
  */
@@ -331,6 +569,70 @@ void QueuedProcess::setUser(const long long _user)
 }
 
 
+/**
+ * @fn setCGroup
+ */
+void QueuedProcess::setCGroup(QueuedControlGroupsAdaptor *_cgroup)
+{
+    qCDebug(LOG_LIB) << "Set control group to" << _cgroup->name();
+
+    delete m_cgroup;
+    m_cgroup = _cgroup;
+    m_cgroup->setParent(this);
+    m_groupCreated = true;
+}
+
+
+/**
+ * @fn setCpuSet
+ */
+void QueuedProcess::setCpuSet(const QList<long long> &_cpus)
+{
+    qCDebug(LOG_LIB) << "Set CPU cores to" << _cpus;
+
+    m_cpuSet = _cpus;
+    if ((state() == QProcess::ProcessState::NotRunning) || m_cpuSet.isEmpty())
+        return;
+    m_cgroup->setCpuSet(m_cpuSet);
+}
+
+
+/**
+ * @fn setGang
+ */
+void QueuedProcess::setGang(const uint _gang)
+{
+    qCDebug(LOG_LIB) << "Set gang size to" << _gang;
+
+    m_definitions.gang = _gang;
+}
+
+
+/**
+ * @fn setMemorySet
+ */
+void QueuedProcess::setMemorySet(const QList<long long> &_nodes)
+{
+    qCDebug(LOG_LIB) << "Set memory nodes to" << _nodes;
+
+    m_memorySet = _nodes;
+    if ((state() == QProcess::ProcessState::NotRunning) || m_memorySet.isEmpty())
+        return;
+    m_cgroup->setMemorySet(m_memorySet);
+}
+
+
+/**
+ * @fn setWalltime
+ */
+void QueuedProcess::setWalltime(const long long _walltime)
+{
+    qCDebug(LOG_LIB) << "Set walltime to" << _walltime;
+
+    m_definitions.walltime = _walltime;
+}
+
+
 /**
  * @fn setWorkDirectory
  */
@@ -362,6 +664,9 @@ bool QueuedProcess::operator==(const QueuedProcess &_other)
  */
 void QueuedProcess::applyCGroup()
 {
+    // process could not join group by itself
+    if (m_groupJoined)
+        return;
     m_cgroup->addProcess(pid());
 }
 
@@ -371,16 +676,13 @@ void QueuedProcess::applyCGroup()
  */
 void QueuedProcess::setupChildProcess()
 {
-    // configure cgroup here and apply limits
-    m_cgroup->createGroup();
-    auto nl = nativeLimits();
-    m_cgroup->setCpuLimit(std::llround(QueuedSystemInfo::cpuWeight(nl.cpu) * 100.0));
-    m_cgroup->setMemoryLimit(
-        std::llround(QueuedSystemInfo::memoryWeight(nl.memory) * QueuedSystemInfo::memoryCount()));
+    // only async-signal-safe calls are allowed after fork, group has been configured by parent,
+    // thus limits are applied before exec. Child runs outside of group if it could not join
+    QueuedControlGroupsAdaptor::addSelf(m_procFiles);
 
-    // setup child properties
-    ::setuid(m_definitions.uid);
+    // setup child properties, group must be changed while process still has privileges
     ::setgid(m_definitions.gid);
+    ::setuid(m_definitions.uid);
 
     return QProcess::setupChildProcess();
 }
@@ -23,6 +23,8 @@
 
 #include <queued/Queued.h>
 
+#include <algorithm>
+#include <cmath>
 #include <csignal>
 
 extern "C" {
@@ -40,8 +42,30 @@ QueuedProcessManager::QueuedProcessManager(QObject *_parent)
     qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
 
     qRegisterMetaType<QueuedEnums::ExitAction>("QueuedEnums::ExitAction");
+    qRegisterMetaType<QueuedEnums::ExitReason>("QueuedEnums::ExitReason");
+    qRegisterMetaType<QueuedEnums::SchedulerPolicy>("QueuedEnums::SchedulerPolicy");
+    qRegisterMetaType<QueuedEnums::PreemptionMode>("QueuedEnums::PreemptionMode");
 
     m_onExit = QueuedEnums::ExitAction::Terminate;
+    m_preemption = QueuedEnums::PreemptionMode::None;
+    m_policy = QueuedSchedulerPolicy::create(QueuedEnums::SchedulerPolicy::Priority, this);
+    m_used = QueuedLimits::Limits(0, 0, 0, 0, 0);
+
+    // reserved resources are released at window end
+    m_reservationTimer.setSingleShot(true);
+    connect(&m_reservationTimer, &QTimer::timeout, [this]() {
+        updateReservationTimer();
+        start();
+    });
+    // delayed tasks are enqueued at their start time, thus the queue is never polled
+    m_wakeupTimer.setSingleShot(true);
+    m_wakeupTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_wakeupTimer, &QTimer::timeout, this, &QueuedProcessManager::wakeup);
+    m_usageTimer.setSingleShot(true);
+    connect(&m_usageTimer, &QTimer::timeout, this, &QueuedProcessManager::sampleTasks);
+    // group becomes empty after the last of task processes, it is notified by inotify
+    connect(&m_events, &QFileSystemWatcher::fileChanged, this,
+            &QueuedProcessManager::groupChanged);
 }
 
 
@@ -52,9 +76,14 @@ QueuedProcessManager::~QueuedProcessManager()
 {
     qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
 
+    m_reservationTimer.stop();
+    m_wakeupTimer.stop();
+    m_usageTimer.stop();
     QList<long long> indices = processes().keys();
     for (auto index : indices)
         remove(index);
+
+    delete m_policy;
 }
 
 
@@ -63,10 +92,11 @@ QueuedProcessManager::~QueuedProcessManager()
  */
 QueuedProcess::QueuedProcessDefinitions
 QueuedProcessManager::parseDefinitions(const QVariantHash &_properties,
-                                       const QList<QVariantHash> &_modifications)
+                                       const QList<QVariantHash> &_modifications,
+                                       const QList<QVariantHash> &_dependencies)
 {
     qCDebug(LOG_LIB) << "Parse definitions from" << _properties << "with modifications"
-                     << _modifications;
+                     << _modifications << "and dependencies" << _dependencies;
 
     QueuedProcess::QueuedProcessDefinitions defs;
     // parameters
@@ -75,6 +105,11 @@ QueuedProcessManager::parseDefinitions(const QVariantHash &_properties,
     defs.workingDirectory = _properties["workDirectory"].toString();
     defs.nice = _properties["nice"].toUInt();
     defs.limits = _properties["limits"].toString();
+    defs.walltime = _properties["walltime"].toLongLong();
+    defs.gang = _properties["gang"].toUInt();
+    defs.startAfter
+        = QDateTime::fromString(_properties["startAfter"].toString(), Qt::ISODateWithMs);
+    defs.deadline = QDateTime::fromString(_properties["deadline"].toString(), Qt::ISODateWithMs);
     // user data
     defs.uid = _properties["uid"].toUInt();
     defs.gid = _properties["gid"].toUInt();
@@ -93,49 +128,137 @@ QueuedProcessManager::parseDefinitions(const QVariantHash &_properties,
         mods.user = mod["user"].toLongLong();
         defs.modifications.append(mods);
     }
+    // dependencies
+    for (auto &dep : _dependencies) {
+        QueuedProcess::QueuedProcessDependency dependency;
+        dependency.task = dep["dependency"].toLongLong();
+        dependency.type = static_cast<QueuedEnums::DependencyType>(dep["type"].toInt());
+        defs.dependencies.append(dependency);
+    }
 
     return defs;
 }
 
 
+/**
+ * @fn parseReservation
+ */
+QueuedProcessManager::QueuedCapacityReservation
+QueuedProcessManager::parseReservation(const QVariantHash &_properties)
+{
+    QueuedCapacityReservation reservation;
+    reservation.user = _properties["user"].toLongLong();
+    reservation.limits = QueuedLimits::Limits(_properties["limits"].toString());
+    reservation.startTime
+        = QDateTime::fromString(_properties["startTime"].toString(), Qt::ISODateWithMs);
+    reservation.endTime
+        = QDateTime::fromString(_properties["endTime"].toString(), Qt::ISODateWithMs);
+    reservation.period = _properties["period"].toLongLong();
+
+    return reservation;
+}
+
+
+/**
+ * @fn addReservation
+ */
+void QueuedProcessManager::addReservation(const long long _id,
+                                          const QueuedCapacityReservation &_reservation)
+{
+    qCDebug(LOG_LIB) << "Add reservation" << _id << "for user" << _reservation.user << "limits"
+                     << _reservation.limits.toString() << "from" << _reservation.startTime
+                     << "to" << _reservation.endTime << "period" << _reservation.period;
+
+    m_reservations[_id] = _reservation;
+    updateReservationTimer();
+}
+
+
+/**
+ * @fn addUsage
+ */
+void QueuedProcessManager::addUsage(const long long _user, const QueuedLimits::Limits &_usage,
+                                    const QDateTime &_time)
+{
+    qCDebug(LOG_LIB) << "Add usage" << _usage.toString() << "of user" << _user << "at" << _time;
+
+    auto now = currentTime();
+    updateUsage(now);
+    m_usage[_user] += share(_usage) * decay(_time, now);
+}
+
+
 /**
  * @fn add
  */
-QueuedProcess *QueuedProcessManager::add(const QVariantHash &_properties,
-                                         const QList<QVariantHash> &_modifications,
-                                         const long long _index)
+void QueuedProcessManager::add(const QVariantHash &_properties,
+                               const QList<QVariantHash> &_modifications, const long long _index,
+                               const QList<QVariantHash> &_dependencies)
 {
     qCDebug(LOG_LIB) << "Add new process" << _properties << "with modifications" << _modifications
                      << "with index" << _index;
 
-    return add(parseDefinitions(_properties, _modifications), _index);
+    add(parseDefinitions(_properties, _modifications, _dependencies), _index);
 }
 
 
 /**
  * @fn add
  */
-QueuedProcess *
-QueuedProcessManager::add(const QueuedProcess::QueuedProcessDefinitions &_definitions,
-                          const long long _index)
+void QueuedProcessManager::add(const QueuedProcess::QueuedProcessDefinitions &_definitions,
+                               const long long _index)
 {
     qCDebug(LOG_LIB) << "Add new process" << _definitions.command << "with index" << _index;
 
-    if (processes().contains(_index))
-        return process(_index);
-
-    auto *process = new QueuedProcess(this, _definitions, _index);
-    m_processes[_index] = process;
-    // connect to signal
-    m_connections[_index] = connect(
-        process, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
-        [=](const int exitCode, const QProcess::ExitStatus exitStatus) {
-            return taskFinished(exitCode, exitStatus, _index);
-        });
+    create(_definitions, _index);
 
     // check if we can start new task
     start();
-    return process;
+}
+
+
+/**
+ * @fn add
+ */
+void QueuedProcessManager::add(
+    const QMap<long long, QueuedProcess::QueuedProcessDefinitions> &_definitions)
+{
+    qCDebug(LOG_LIB) << "Add" << _definitions.count() << "new processes";
+
+    for (auto it = _definitions.cbegin(); it != _definitions.cend(); ++it)
+        create(it.value(), it.key());
+
+    // single pass for all tasks
+    start();
+}
+
+
+/**
+ * @fn contains
+ */
+bool QueuedProcessManager::contains(const long long _index) const
+{
+    return m_pending.contains(_index) || m_processes.contains(_index);
+}
+
+
+/**
+ * @fn pendingQueue
+ */
+const QueuedProcessManager::QueuedPendingQueue &QueuedProcessManager::pendingQueue() const
+{
+    return m_queue;
+}
+
+
+/**
+ * @fn pendingTask
+ */
+const QueuedProcessManager::QueuedPendingTask *
+QueuedProcessManager::pendingTask(const long long _index) const
+{
+    auto it = m_pending.constFind(_index);
+    return it == m_pending.cend() ? nullptr : &it.value();
 }
 
 
@@ -166,13 +289,35 @@ void QueuedProcessManager::remove(const long long _index)
 {
     qCDebug(LOG_LIB) << "Remove process by index" << _index;
 
+    // pending task has neither process nor reserved resources
+    if (m_pending.remove(_index) > 0) {
+        dequeue(_index);
+        m_waiting.remove(_index);
+        return;
+    }
     if (!processes().contains(_index))
         return;
 
+    bool suspended = m_suspended.contains(_index);
+    release(_index);
     QueuedProcess *pr = m_processes.take(_index);
-    auto connection = m_connections.take(_index);
-    disconnect(connection);
+    for (auto &connection : m_connections.take(_index))
+        disconnect(connection);
+    auto events = pr->cgroup()->eventsFile();
+    bool watched = m_eventFiles.remove(events) > 0;
+    auto memoryEvents = pr->cgroup()->memoryEventsFile();
+    m_oomKills.remove(_index);
+    if (m_memoryEventFiles.remove(memoryEvents) > 0)
+        m_events.removePath(memoryEvents);
 
+    // main process has exited, its children are reparented and may be found by group only
+    if ((m_exited.remove(_index) > 0) && pr->cgroup()->populated()) {
+        pr->cgroup()->sendSignal(SIGKILL);
+        m_orphans[events] = pr;
+        return;
+    }
+    if (watched)
+        m_events.removePath(events);
     switch (onExit()) {
     case QueuedEnums::ExitAction::Kill:
         pr->kill();
@@ -181,46 +326,154 @@ void QueuedProcessManager::remove(const long long _index)
         pr->terminate();
         break;
     }
+    // stopped process handles signals only after continue
+    if (suspended)
+        pr->resume();
 
     pr->deleteLater();
 }
 
 
+/**
+ * @fn removeReservation
+ */
+void QueuedProcessManager::removeReservation(const long long _id)
+{
+    qCDebug(LOG_LIB) << "Remove reservation" << _id;
+
+    m_reservations.remove(_id);
+    updateReservationTimer();
+}
+
+
+/**
+ * @fn setQuota
+ */
+void QueuedProcessManager::setQuota(const long long _user, const long long _tasks,
+                                    const QueuedLimits::Limits &_limits)
+{
+    qCDebug(LOG_LIB) << "Set quota of user" << _user << "tasks" << _tasks << "limits"
+                     << _limits.toString();
+
+    if ((_tasks <= 0) && (_limits.cpu <= 0) && (_limits.memory <= 0)) {
+        m_quotas.remove(_user);
+        return;
+    }
+
+    QueuedUserQuota quota;
+    quota.tasks = _tasks;
+    quota.limits = _limits;
+    m_quotas[_user] = quota;
+}
+
+
+/**
+ * @fn update
+ */
+void QueuedProcessManager::update(const long long _index,
+                                  const QueuedProcess::QueuedProcessDefinitions &_definitions)
+{
+    qCDebug(LOG_LIB) << "Update task" << _index << "in queue";
+
+    if (!m_pending.contains(_index))
+        return;
+
+    auto &task = m_pending[_index];
+    task.definitions = _definitions;
+    task.limits = taskLimits(_definitions);
+    // task which waits for dependencies will be enqueued later
+    if (m_waiting.contains(_index))
+        return;
+    // earliest start time might be changed as well
+    dequeue(_index);
+    enqueue(_index);
+
+    // priority or limits might be changed
+    start();
+}
+
+
 /**
  * @fn start
  */
 void QueuedProcessManager::start()
 {
-    qCDebug(LOG_LIB) << "Start random task";
+    qCDebug(LOG_LIB) << "Start tasks from queue";
 
-    long long index = -1;
-    // gather used resources
-    QueuedLimits::Limits limits = usedLimits();
-    double weightedCpu = limits.cpu == 0 ? 0.0 : QueuedSystemInfo::cpuWeight(limits.cpu);
-    double weightedMemory
-        = limits.memory == 0 ? 0.0 : QueuedSystemInfo::memoryWeight(limits.memory);
+    QElapsedTimer timer;
+    timer.start();
+    bool usageAdmission = admissionInterval() > 0;
+    // suspended tasks have been started already, thus they are continued first
+    resumeTasks();
+    // resources which may be used by new tasks during the pass
+    auto available = freeLimits();
 
-    auto tasks = processes().values();
-    for (auto pr : tasks) {
-        // check task state
-        if (pr->state() != QProcess::ProcessState::NotRunning)
+    QDateTime start = currentTime();
+    QList<long long> started;
+    // tasks of users which have reached their quota do not block others
+    QList<long long> skipped;
+    while (!m_queue.isEmpty()) {
+        // the first task in queue is the one with the highest priority
+        auto index = m_policy->next();
+        if (!withinQuota(index)) {
+            qCDebug(LOG_SCHED) << "Task" << index << "is skipped by user quota";
+            dequeue(index);
+            skipped.append(index);
             continue;
-        // check limits first
-        if (((1.0 - weightedCpu) < QueuedSystemInfo::cpuWeight(pr->nativeLimits().cpu))
-            && ((1.0 - weightedMemory) < QueuedSystemInfo::memoryWeight(pr->nativeLimits().memory)))
+        }
+        auto &limits = m_pending[index].limits;
+        auto required = requiredLimits(limits);
+        // task without declared limits is admitted by actual usage, but until it is sampled the
+        // whole reservation is counted, thus the next tasks will wait for the sample
+        auto expected = required;
+        if (usageAdmission) {
+            expected.cpu = (limits.cpu > 0) ? required.cpu : 0;
+            expected.memory = (limits.memory > 0) ? required.memory : 0;
+        }
+        // resources reserved for other users are required by preemption as well
+        auto reserved = reservedLimits(index);
+        // check limits, task will wait until resources are released otherwise. Reservations are
+        // not related to actual usage, thus tasks are not preempted by usage based admission
+        if ((expected.cpu > available.cpu) || (expected.memory > available.memory)) {
+            if (usageAdmission || !preempt(index, reserved)) {
+                qCDebug(LOG_SCHED) << "Task" << index << "requires" << expected.cpu << "cores and"
+                                   << expected.memory << "memory, available" << available.cpu
+                                   << "cores and" << available.memory << "memory";
+                m_admissionBlocked = usageAdmission;
+                break;
+            }
+            // task is started right now, otherwise requeued victim might take its place
+            available = freeLimits();
+            reserved = reservedLimits(index);
+        }
+        // resources reserved for other users do not block the queue, the task just waits
+        if ((expected.cpu > available.cpu - reserved.cpu)
+            || (expected.memory > available.memory - reserved.memory)) {
+            qCDebug(LOG_SCHED) << "Task" << index << "is skipped by reservations"
+                               << reserved.toString();
+            dequeue(index);
+            skipped.append(index);
             continue;
-        // now check nice level
-        if ((index > -1) && (pr->nice() < process(index)->nice()))
-            continue;
-        // now check index value
-        if ((index > -1) && (pr->index() > index))
-            continue;
-        // hmmm, looks like we found a candidate
-        index = pr->index();
+        }
+
+        available.cpu -= required.cpu;
+        available.memory -= required.memory;
+        launch(index, start);
+        started.append(index);
     }
+    // try to fill free resources with other tasks
+    if (m_policy->backfill() && !usageAdmission)
+        started += backfillTasks(start);
+    for (auto index : skipped)
+        enqueue(index);
 
-    if (index > -1)
-        return start(index);
+    // notify about started tasks after the whole pass
+    qCInfo(LOG_LIB) << "Started tasks" << started;
+    m_schedulingPass.record(timer.nsecsElapsed() / 1000);
+    qCDebug(LOG_SCHED) << "Scheduling pass took" << timer.nsecsElapsed() / 1000 << "us, started"
+                       << started.count() << "tasks," << m_queue.count() << "tasks are queued";
+    for (auto index : started)
+        emit(taskStartTimeReceived(index, start));
 }
 
 
@@ -231,20 +484,37 @@ void QueuedProcessManager::start(const long long _index)
 {
     qCDebug(LOG_LIB) << "Start task" << _index;
 
-    auto pr = process(_index);
-    if (!pr) {
-        qCWarning(LOG_LIB) << "No task" << _index << "found";
+    if (!m_pending.contains(_index)) {
+        if (process(_index))
+            qCWarning(LOG_LIB) << "Task" << _index << "is already running";
+        else
+            qCWarning(LOG_LIB) << "No task" << _index << "found";
         return;
     }
 
-    QDateTime start = QDateTime::currentDateTimeUtc();
-    pr->start();
+    QDateTime start = currentTime();
+    launch(_index, start);
     // emit start time
-    pr->setStartTime(start);
     emit(taskStartTimeReceived(_index, start));
 }
 
 
+/**
+ * @fn statistics
+ */
+QHash<QString, QHash<QString, QString>> QueuedProcessManager::statistics() const
+{
+    return {
+        {"Deadlines",
+         {{"met", QString::number(m_deadlinesMet)},
+          {"missed", QString::number(m_deadlinesMissed)}}},
+        {"Dispatch latency", m_dispatchLatency.summary()},
+        {"Queue wait", m_queueWait.summary()},
+        {"Scheduling pass", m_schedulingPass.summary()},
+    };
+}
+
+
 /**
  * @fn stop
  */
@@ -252,12 +522,26 @@ void QueuedProcessManager::stop(const long long _index)
 {
     qCDebug(LOG_LIB) << "Stop task" << _index;
 
+    // there is no process for pending task yet, thus it is just cancelled
+    if (m_pending.contains(_index)) {
+        cancel(_index);
+        return;
+    }
+
     auto pr = process(_index);
     if (!pr) {
         qCWarning(LOG_LIB) << "No task" << _index << "found";
         return;
     }
 
+    // there are no children of exited main process, task will be finished once group is empty
+    if (m_exited.contains(_index)) {
+        pr->cgroup()->sendSignal((onExit() == QueuedEnums::ExitAction::Kill) ? SIGKILL : SIGTERM);
+        if (m_suspended.contains(_index))
+            pr->cgroup()->sendSignal(SIGCONT);
+        return;
+    }
+
     pr->killChildren();
     switch (onExit()) {
     case QueuedEnums::ExitAction::Kill:
@@ -267,6 +551,83 @@ void QueuedProcessManager::stop(const long long _index)
         pr->terminate();
         break;
     }
+    if (m_suspended.contains(_index))
+        pr->resume();
+}
+
+
+/**
+ * @fn usage
+ */
+double QueuedProcessManager::usage(const long long _user) const
+{
+    auto now = currentTime();
+    double history = m_usage.value(_user, 0.0) * decay(m_usageTime, now);
+    // running tasks are charged as if they hold resources for the whole half life period
+    return history + m_runningShare.value(_user, 0.0) * fairShareHalfLife();
+}
+
+
+/**
+ * @fn userQueues
+ */
+const QueuedProcessManager::QueuedUserQueueMap &QueuedProcessManager::userQueues() const
+{
+    return m_userQueues;
+}
+
+
+/**
+ * @fn admissionHysteresis
+ */
+long long QueuedProcessManager::admissionHysteresis() const
+{
+    return m_admissionHysteresis;
+}
+
+
+/**
+ * @fn admissionInterval
+ */
+long long QueuedProcessManager::admissionInterval() const
+{
+    return m_admissionInterval;
+}
+
+
+/**
+ * @fn admissionMargin
+ */
+long long QueuedProcessManager::admissionMargin() const
+{
+    return m_admissionMargin;
+}
+
+
+/**
+ * @fn cpuPinning
+ */
+bool QueuedProcessManager::cpuPinning() const
+{
+    return m_cpuPinning;
+}
+
+
+/**
+ * @fn fairShareHalfLife
+ */
+long long QueuedProcessManager::fairShareHalfLife() const
+{
+    return m_halfLife;
+}
+
+
+/**
+ * @fn groupPool
+ */
+long long QueuedProcessManager::groupPool() const
+{
+    return m_groupPool;
 }
 
 
@@ -279,6 +640,125 @@ QueuedEnums::ExitAction QueuedProcessManager::onExit() const
 }
 
 
+/**
+ * @fn policy
+ */
+QueuedEnums::SchedulerPolicy QueuedProcessManager::policy() const
+{
+    return m_policy->type();
+}
+
+
+/**
+ * @fn preemption
+ */
+QueuedEnums::PreemptionMode QueuedProcessManager::preemption() const
+{
+    return m_preemption;
+}
+
+
+/**
+ * @fn usageInterval
+ */
+long long QueuedProcessManager::usageInterval() const
+{
+    return m_usageInterval;
+}
+
+
+/**
+ * @fn setAdmissionHysteresis
+ */
+void QueuedProcessManager::setAdmissionHysteresis(const long long _hysteresis)
+{
+    qCDebug(LOG_LIB) << "Set admission hysteresis to" << _hysteresis;
+
+    if ((_hysteresis < 0) || (_hysteresis >= 100)) {
+        qCWarning(LOG_LIB) << "Invalid hysteresis" << _hysteresis << ", ignore";
+        return;
+    }
+
+    m_admissionHysteresis = _hysteresis;
+}
+
+
+/**
+ * @fn setAdmissionInterval
+ */
+void QueuedProcessManager::setAdmissionInterval(const long long _interval)
+{
+    qCDebug(LOG_LIB) << "Set admission interval to" << _interval;
+
+    m_admissionInterval = std::min(std::max(_interval, 0ll), 86400000ll);
+    m_admissionBlocked = false;
+
+    m_usageTimer.stop();
+    if ((shortestUsageInterval() > 0) && !m_processes.isEmpty())
+        m_usageTimer.start(static_cast<int>(shortestUsageInterval()));
+}
+
+
+/**
+ * @fn setAdmissionMargin
+ */
+void QueuedProcessManager::setAdmissionMargin(const long long _margin)
+{
+    qCDebug(LOG_LIB) << "Set admission margin to" << _margin;
+
+    if ((_margin < 0) || (_margin >= 100)) {
+        qCWarning(LOG_LIB) << "Invalid margin" << _margin << ", ignore";
+        return;
+    }
+
+    m_admissionMargin = _margin;
+}
+
+
+/**
+ * @fn setCpuPinning
+ */
+void QueuedProcessManager::setCpuPinning(const bool _pinning)
+{
+    qCDebug(LOG_LIB) << "Set CPU pinning to" << _pinning;
+
+    m_cpuPinning = _pinning;
+}
+
+
+/**
+ * @fn setFairShareHalfLife
+ */
+void QueuedProcessManager::setFairShareHalfLife(const long long _halfLife)
+{
+    qCDebug(LOG_LIB) << "Set fair share half life to" << _halfLife;
+
+    if (_halfLife <= 0) {
+        qCWarning(LOG_LIB) << "Invalid half life" << _halfLife << ", ignore";
+        return;
+    }
+
+    // apply previous half life to stored values before change
+    updateUsage(currentTime());
+    m_halfLife = _halfLife;
+}
+
+
+/**
+ * @fn setGroupPool
+ */
+void QueuedProcessManager::setGroupPool(const long long _size)
+{
+    qCDebug(LOG_LIB) << "Set control group pool size to" << _size;
+
+    m_groupPool = std::max(0LL, _size);
+    // extra groups are removed by adaptor destructor
+    while (m_groups.count() > m_groupPool)
+        delete m_groups.takeLast();
+    fillGroupPool();
+}
+
+
 /**
  * @fn setExitAction
  */
@@ -301,53 +781,1084 @@ void QueuedProcessManager::setExitAction(const QueuedEnums::ExitAction _action)
 
 
 /**
- * @fn usedLimits
+ * @fn setPolicy
  */
-QueuedLimits::Limits QueuedProcessManager::usedLimits()
+void QueuedProcessManager::setPolicy(const QueuedEnums::SchedulerPolicy _policy)
 {
-    auto tasks = processes().values();
-    long long cpu = std::accumulate(
-        tasks.cbegin(), tasks.cend(), 0, [](long long value, QueuedProcess *process) {
-            auto limit = process->nativeLimits().cpu == 0 ? QueuedSystemInfo::cpuCount()
-                                                          : process->nativeLimits().cpu;
-            return process->state() == QProcess::ProcessState::Running ? value + limit : value;
-        });
-    long long memory = std::accumulate(
-        tasks.cbegin(), tasks.cend(), 0, [](long long value, QueuedProcess *process) {
-            auto limit = process->nativeLimits().memory == 0 ? QueuedSystemInfo::memoryCount()
-                                                             : process->nativeLimits().memory;
-            return process->state() == QProcess::ProcessState::Running ? value + limit : value;
-        });
-    long long storage = std::accumulate(
-        tasks.cbegin(), tasks.cend(), 0, [](long long value, QueuedProcess *process) {
-            return process->state() == QProcess::ProcessState::Running
-                       ? value + process->nativeLimits().storage
-                       : value;
-        });
+    qCDebug(LOG_LIB) << "Set scheduler policy" << static_cast<int>(_policy);
 
-    return QueuedLimits::Limits(cpu, 0, memory, 0, storage);
+    delete m_policy;
+    m_policy = QueuedSchedulerPolicy::create(_policy, this);
+
+    // rank depends on policy, thus pending queue must be rebuilt
+    auto pending = m_queue.values();
+    m_queue.clear();
+    m_queueKeys.clear();
+    m_userQueues.clear();
+    for (auto index : pending)
+        enqueue(index);
 }
 
 
 /**
- * @fn taskFinished
+ * @fn setPreemption
  */
-void QueuedProcessManager::taskFinished(const int _exitCode, const QProcess::ExitStatus _exitStatus,
-                                        const long long _index)
+void QueuedProcessManager::setPreemption(const QueuedEnums::PreemptionMode _mode)
 {
-    qCDebug(LOG_LIB) << "Process" << _index << "finished with code" << _exitCode << "and status"
-                     << _exitStatus;
+    qCDebug(LOG_LIB) << "Set preemption mode" << static_cast<int>(_mode);
 
-    auto pr = process(_index);
-    if (pr) {
-        // change log rights to valid one
-        ::chown(qPrintable(pr->logError()), pr->uid(), pr->gid());
-        ::chown(qPrintable(pr->logOutput()), pr->uid(), pr->gid());
-        // remove task
-        auto endTime = QDateTime::currentDateTimeUtc();
-        remove(_index);
-        emit(taskStopTimeReceived(_index, endTime));
-    }
+    m_preemption = _mode;
+    if (preemption() == QueuedEnums::PreemptionMode::Suspend)
+        return;
 
-    start();
+    // there is no one who will continue suspended tasks
+    for (auto index : m_suspended.values())
+        resume(index);
+}
+
+
+/**
+ * @fn setUsageInterval
+ */
+void QueuedProcessManager::setUsageInterval(const long long _interval)
+{
+    qCDebug(LOG_LIB) << "Set usage interval to" << _interval;
+
+    m_usageInterval = std::min(std::max(_interval, 0ll), 86400000ll);
+
+    m_usageTimer.stop();
+    if ((shortestUsageInterval() > 0) && !m_processes.isEmpty())
+        m_usageTimer.start(static_cast<int>(shortestUsageInterval()));
+}
+
+
+/**
+ * @fn usedLimits
+ */
+QueuedLimits::Limits QueuedProcessManager::usedLimits() const
+{
+    return m_used;
+}
+
+
+/**
+ * @fn requiredLimits
+ */
+QueuedLimits::Limits QueuedProcessManager::requiredLimits(const QueuedLimits::Limits &_limits)
+{
+    auto limits = _limits;
+    // empty or too big limits mean the whole system
+    if ((limits.cpu <= 0) || (limits.cpu > QueuedSystemInfo::cpuCount()))
+        limits.cpu = QueuedSystemInfo::cpuCount();
+    if ((limits.memory <= 0) || (limits.memory > QueuedSystemInfo::memoryCount()))
+        limits.memory = QueuedSystemInfo::memoryCount();
+
+    return limits;
+}
+
+
+/**
+ * @fn currentTime
+ */
+QDateTime QueuedProcessManager::currentTime() const
+{
+    return QDateTime::currentDateTimeUtc();
+}
+
+
+/**
+ * @fn startProcess
+ */
+void QueuedProcessManager::startProcess(QueuedProcess *_process)
+{
+    // group creation is moved out of launch path, pool is refilled once event loop is free
+    if (!m_groups.isEmpty()) {
+        _process->setCGroup(m_groups.takeFirst());
+        QTimer::singleShot(0, this, [this]() { fillGroupPool(); });
+    }
+
+    _process->launch();
+
+    // main process exit does not mean that task is finished, thus its group is watched as well
+    auto events = _process->cgroup()->eventsFile();
+    if (!events.isEmpty() && m_events.addPath(events))
+        m_eventFiles[events] = _process->index();
+    // OOM killer may kill any process of group without task exit
+    auto memoryEvents = _process->cgroup()->memoryEventsFile();
+    if (!memoryEvents.isEmpty() && m_events.addPath(memoryEvents))
+        m_memoryEventFiles[memoryEvents] = _process->index();
+}
+
+
+/**
+ * @fn groupChanged
+ */
+void QueuedProcessManager::groupChanged(const QString &_path)
+{
+    // object of removed task is kept until its group could be removed
+    auto orphan = m_orphans.value(_path, nullptr);
+    if (orphan) {
+        if (orphan->cgroup()->populated())
+            return;
+        qCDebug(LOG_SCHED) << "Group of removed task" << orphan->index() << "has become empty";
+        m_events.removePath(_path);
+        m_orphans.remove(_path);
+        orphan->deleteLater();
+        return;
+    }
+
+    if (m_memoryEventFiles.contains(_path)) {
+        auto index = m_memoryEventFiles[_path];
+        auto pr = process(index);
+        auto kills = pr ? pr->cgroup()->oomKills() : 0;
+        if (kills > m_oomKills.value(index, 0)) {
+            qCWarning(LOG_LIB) << "Processes of task" << index << "have been killed by OOM killer,"
+                               << kills << "kills in total";
+            m_oomKills[index] = kills;
+        }
+        return;
+    }
+
+    auto index = m_eventFiles.value(_path, -1);
+    // main process is still running or task has been already finished
+    if (!m_exited.contains(index))
+        return;
+    auto pr = process(index);
+    if (pr && pr->cgroup()->populated())
+        return;
+
+    qCDebug(LOG_SCHED) << "Group of task" << index << "has become empty";
+    auto status = m_exited.take(index);
+    taskFinished(status.first, status.second, index);
+}
+
+
+/**
+ * @fn taskFinished
+ */
+void QueuedProcessManager::taskFinished(const int _exitCode, const QProcess::ExitStatus _exitStatus,
+                                        const long long _index)
+{
+    qCDebug(LOG_LIB) << "Process" << _index << "finished with code" << _exitCode << "and status"
+                     << _exitStatus;
+
+    auto pr = process(_index);
+    // children are still running, group change will finish task
+    if (pr && m_eventFiles.contains(pr->cgroup()->eventsFile()) && pr->cgroup()->populated()) {
+        qCDebug(LOG_SCHED) << "Main process of task" << _index << "has exited before children";
+        m_exited[_index] = {_exitCode, _exitStatus};
+        return;
+    }
+    if (pr) {
+        // change log rights to valid one
+        ::chown(qPrintable(pr->logError()), pr->uid(), pr->gid());
+        ::chown(qPrintable(pr->logOutput()), pr->uid(), pr->gid());
+        // remove task
+        auto endTime = currentTime();
+        if (m_running.contains(_index)) {
+            auto reservation = m_running[_index];
+            reservation.limits *= pr->startTime().secsTo(endTime);
+            addUsage(reservation.user, reservation.limits, endTime);
+        }
+        if (pr->deadline().isValid()) {
+            if (endTime > pr->deadline()) {
+                qCInfo(LOG_SCHED) << "Task" << _index << "has missed its deadline"
+                                  << pr->deadline();
+                m_deadlinesMissed++;
+            } else {
+                m_deadlinesMet++;
+            }
+        }
+        // group is removed together with process, thus the final sample is taken before
+        pr->sampleUsage(QDateTime::currentDateTimeUtc());
+        auto cpuTime = pr->cpuTime();
+        auto memoryPeak = pr->memoryPeak();
+        auto ioBytes = pr->ioBytes();
+        auto reason = _exitStatus == QProcess::ExitStatus::NormalExit
+                          ? QueuedEnums::ExitReason::Exit
+                          : QueuedEnums::ExitReason::Crash;
+        // OOM killer might kill any process of group, but task result is affected anyway
+        if (pr->oomKills() > 0) {
+            qCWarning(LOG_LIB) << "Processes of task" << _index << "have been killed by OOM killer";
+            reason = QueuedEnums::ExitReason::OutOfMemory;
+        }
+        remove(_index);
+        bool success = (_exitStatus == QProcess::ExitStatus::NormalExit) && (_exitCode == 0);
+        emit(taskUsageReceived(_index, cpuTime, memoryPeak, ioBytes));
+        emit(taskExitCodeReceived(
+            _index, _exitStatus == QProcess::ExitStatus::NormalExit ? _exitCode : -1, reason));
+        emit(taskStopTimeReceived(_index, endTime));
+        // dependent tasks might be queued now
+        resolve(_index, success);
+    }
+
+    start();
+}
+
+
+/**
+ * @fn allocateCores
+ */
+void QueuedProcessManager::allocateCores(const long long _index)
+{
+    auto pr = m_processes[_index];
+    if ((pr->gang() == 0) && !cpuPinning())
+        return;
+    // reservation counts task without CPU limit as the whole system, thus declared limit is used
+    auto declared = taskLimits(pr->definitions()).cpu;
+    if (declared <= 0) {
+        // task without CPU limit must not interfere with dedicated cores
+        if (!m_cores.isEmpty())
+            pr->setCpuSet(sharedCores());
+        return;
+    }
+    // gang size is already included into limits, too big limit is truncated by reservation
+    auto count = static_cast<int>(std::min(declared, m_running[_index].limits.cpu));
+
+    // free cores grouped by NUMA nodes
+    auto shared = sharedCores();
+    auto nodes = QueuedSystemInfo::numaNodes();
+    QHash<long long, QList<long long>> free;
+    for (auto it = nodes.cbegin(); it != nodes.cend(); ++it) {
+        for (auto cpu : it.value()) {
+            if (shared.contains(cpu))
+                free[it.key()].append(cpu);
+        }
+    }
+    auto order = free.keys();
+    std::sort(order.begin(), order.end(), [&free](const long long _first, const long long _second) {
+        auto first = free[_first].count();
+        auto second = free[_second].count();
+        return (first == second) ? (_first < _second) : (first < second);
+    });
+    // the best fitting node keeps other nodes free for large tasks
+    auto fit = std::find_if(order.cbegin(), order.cend(),
+                            [&free, count](const long long _node) {
+                                return free[_node].count() >= count;
+                            });
+    if (fit == order.cend())
+        std::reverse(order.begin(), order.end());
+    else
+        order = {*fit};
+
+    QList<long long> cores;
+    QList<long long> mems;
+    for (auto node : order) {
+        if (cores.count() >= count)
+            break;
+        auto &nodeCores = free[node];
+        cores += nodeCores.mid(std::max(nodeCores.count() - count + cores.count(), 0));
+        mems.append(node);
+    }
+    std::sort(mems.begin(), mems.end());
+    m_cores[_index] = cores;
+    qCInfo(LOG_LIB) << "Dedicate cores" << cores << "on nodes" << mems << "to task" << _index;
+
+    pr->setCpuSet(cores);
+    pr->setMemorySet(mems);
+    updateCpuSets();
+}
+
+
+/**
+ * @fn backfillTasks
+ */
+QList<long long> QueuedProcessManager::backfillTasks(const QDateTime &_time)
+{
+    qCDebug(LOG_LIB) << "Backfill tasks at" << _time;
+
+    QList<long long> started;
+    if (m_queue.count() < 2)
+        return started;
+
+    long long cpuCount = QueuedSystemInfo::cpuCount();
+    long long memoryCount = QueuedSystemInfo::memoryCount();
+
+    // expected release times of resources, tasks without estimation are never released
+    QMultiMap<QDateTime, QueuedLimits::Limits> releases;
+    for (auto it = m_running.cbegin(); it != m_running.cend(); ++it) {
+        auto pr = process(it.key());
+        if (pr->walltime() <= 0)
+            continue;
+        // task which exceeds its estimation is expected to end soon
+        releases.insert(std::max(pr->startTime().addSecs(pr->walltime()), _time),
+                        it.value().limits);
+    }
+
+    // find reservation time for the first task in queue
+    auto head = m_policy->next();
+    auto headRequired = requiredLimits(m_pending[head].limits);
+    long long freeCpu = cpuCount - m_used.cpu;
+    long long freeMemory = memoryCount - m_used.memory;
+    QDateTime shadow;
+    for (auto it = releases.cbegin(); it != releases.cend(); ++it) {
+        freeCpu += it.value().cpu;
+        freeMemory += it.value().memory;
+        if ((headRequired.cpu <= freeCpu) && (headRequired.memory <= freeMemory)) {
+            shadow = it.key();
+            break;
+        }
+    }
+    if (!shadow.isValid()) {
+        qCInfo(LOG_LIB) << "Could not estimate start time of task" << head;
+        return started;
+    }
+    // resources which will not be used by the first task at reservation time
+    long long extraCpu = freeCpu - headRequired.cpu;
+    long long extraMemory = freeMemory - headRequired.memory;
+    qCDebug(LOG_LIB) << "Task" << head << "reserved at" << shadow << "extra cpu" << extraCpu
+                     << "extra memory" << extraMemory;
+
+    auto queue = m_queue.values();
+    queue.removeOne(head);
+    for (auto index : queue) {
+        // quota is checked against the tasks launched by this pass as well
+        if (!withinQuota(index))
+            continue;
+        auto &task = m_pending[index];
+        auto required = requiredLimits(task.limits);
+        auto reserved = reservedLimits(index);
+        if ((required.cpu > cpuCount - m_used.cpu - reserved.cpu)
+            || (required.memory > memoryCount - m_used.memory - reserved.memory))
+            continue;
+        // task must either end before reservation or fit into resources left after it
+        auto walltime = task.definitions.walltime;
+        bool endsBefore = (walltime > 0) && (_time.addSecs(walltime) <= shadow);
+        if (!endsBefore) {
+            if ((required.cpu > extraCpu) || (required.memory > extraMemory))
+                continue;
+            extraCpu -= required.cpu;
+            extraMemory -= required.memory;
+        }
+
+        launch(index, _time);
+        started.append(index);
+    }
+
+    return started;
+}
+
+
+/**
+ * @fn cancel
+ */
+void QueuedProcessManager::cancel(const long long _index)
+{
+    qCInfo(LOG_LIB) << "Cancel task" << _index;
+
+    remove(_index);
+    emit(taskExitCodeReceived(_index, -1, QueuedEnums::ExitReason::Cancel));
+    emit(taskStopTimeReceived(_index, currentTime()));
+    // tasks which depend on cancelled one should be processed as well
+    resolve(_index, false);
+}
+
+
+/**
+ * @fn create
+ */
+void QueuedProcessManager::create(const QueuedProcess::QueuedProcessDefinitions &_definitions,
+                                  const long long _index)
+{
+    qCDebug(LOG_LIB) << "Create process" << _definitions.command << "with index" << _index;
+
+    if (contains(_index))
+        return;
+
+    QueuedPendingTask task;
+    task.definitions = _definitions;
+    task.limits = taskLimits(_definitions);
+    task.queued.start();
+    m_pending[_index] = task;
+
+    // finished dependencies have been already checked, thus wait for active ones only
+    for (auto &dependency : _definitions.dependencies) {
+        if (!contains(dependency.task))
+            continue;
+        m_waiting[_index].insert(dependency.task);
+        m_dependents[dependency.task][_index] = dependency.type;
+    }
+    if (m_waiting.contains(_index)) {
+        qCInfo(LOG_LIB) << "Task" << _index << "waits for" << m_waiting[_index];
+        return;
+    }
+    enqueue(_index);
+}
+
+
+/**
+ * @fn decay
+ */
+double QueuedProcessManager::decay(const QDateTime &_from, const QDateTime &_to) const
+{
+    if (!_from.isValid())
+        return 1.0;
+
+    auto elapsed = std::max(_from.secsTo(_to), 0ll);
+    return std::exp2(-static_cast<double>(elapsed) / fairShareHalfLife());
+}
+
+
+/**
+ * @fn dequeue
+ */
+void QueuedProcessManager::dequeue(const long long _index)
+{
+    qCDebug(LOG_LIB) << "Dequeue task" << _index;
+
+    if (!m_queueKeys.contains(_index)) {
+        // task might wait for its start time
+        for (auto it = m_delayed.begin(); it != m_delayed.end(); ++it) {
+            if (it.value() != _index)
+                continue;
+            m_delayed.erase(it);
+            updateWakeupTimer();
+            break;
+        }
+        return;
+    }
+
+    auto key = m_queueKeys.take(_index);
+    m_queue.remove(key);
+    m_userQueues[key.user].remove(key);
+    if (m_userQueues[key.user].isEmpty())
+        m_userQueues.remove(key.user);
+}
+
+
+/**
+ * @fn enqueue
+ */
+void QueuedProcessManager::enqueue(const long long _index)
+{
+    auto &definitions = m_pending[_index].definitions;
+    // task which may not be started yet is enqueued later by timer
+    if (definitions.startAfter.isValid() && (definitions.startAfter > currentTime())) {
+        qCDebug(LOG_LIB) << "Delay task" << _index << "until" << definitions.startAfter;
+        m_delayed.insert(definitions.startAfter, _index);
+        updateWakeupTimer();
+        return;
+    }
+
+    QueuedPendingKey key;
+    key.rank = m_policy->rank(definitions);
+    key.index = _index;
+    key.user = definitions.user;
+    qCDebug(LOG_LIB) << "Enqueue task" << key.index << "with rank" << key.rank;
+
+    m_queue.insert(key, _index);
+    m_queueKeys[key.index] = key;
+    m_userQueues[key.user].insert(key, _index);
+}
+
+
+/**
+ * @fn fillGroupPool
+ */
+void QueuedProcessManager::fillGroupPool()
+{
+    while (m_groups.count() < m_groupPool) {
+        auto name = QString("queued-pool-%1-%2").arg(::getpid()).arg(++m_groupIndex);
+        auto cgroup = new QueuedControlGroupsAdaptor(this, name);
+        if (!cgroup->createGroup()) {
+            qCWarning(LOG_LIB) << "Could not create pooled control group" << name;
+            delete cgroup;
+            return;
+        }
+        m_groups.append(cgroup);
+    }
+}
+
+
+/**
+ * @fn freeLimits
+ */
+QueuedLimits::Limits QueuedProcessManager::freeLimits()
+{
+    long long cpuCount = QueuedSystemInfo::cpuCount();
+    long long memoryCount = QueuedSystemInfo::memoryCount();
+    if (admissionInterval() <= 0)
+        return QueuedLimits::Limits(cpuCount - m_used.cpu, 0, memoryCount - m_used.memory, 0, 0);
+
+    // tasks which have not been sampled yet are counted by their reservations
+    long long cpu = 0;
+    long long memory = 0;
+    for (auto it = m_running.cbegin(); it != m_running.cend(); ++it) {
+        auto pr = process(it.key());
+        auto usage = pr ? pr->nativeUsage() : QueuedUsageHistory::QueuedUsagePoint();
+        if (usage.time > 0) {
+            cpu += static_cast<long long>(std::ceil(usage.cpu));
+            memory += usage.memory;
+        } else {
+            cpu += it.value().limits.cpu;
+            memory += it.value().limits.memory;
+        }
+    }
+
+    double high = (100.0 - admissionMargin()) / 100.0;
+    double low = (100.0 - admissionMargin() - admissionHysteresis()) / 100.0;
+    // after overload new tasks are admitted only once usage has dropped below lower threshold
+    if (m_admissionBlocked) {
+        if ((cpu > cpuCount * low) || (memory > memoryCount * low)) {
+            qCDebug(LOG_LIB) << "Admission is blocked, used cpu" << cpu << "memory" << memory;
+            return QueuedLimits::Limits(-1, 0, -1, 0, 0);
+        }
+        m_admissionBlocked = false;
+    }
+
+    return QueuedLimits::Limits(std::llround(cpuCount * high) - cpu, 0,
+                                std::llround(memoryCount * high) - memory, 0, 0);
+}
+
+
+/**
+ * @fn preempt
+ */
+bool QueuedProcessManager::preempt(const long long _index, const QueuedLimits::Limits &_reserved)
+{
+    if (preemption() == QueuedEnums::PreemptionMode::None)
+        return false;
+    qCDebug(LOG_LIB) << "Try to preempt tasks for" << _index;
+
+    auto &task = m_pending[_index];
+    // nothing is preempted for task which would be skipped by reservations anyway
+    auto required = requiredLimits(task.limits);
+    required.cpu += _reserved.cpu;
+    required.memory += _reserved.memory;
+    // stopped process keeps its memory
+    bool releaseMemory = preemption() == QueuedEnums::PreemptionMode::Requeue;
+
+    QList<long long> candidates;
+    for (auto it = m_processes.cbegin(); it != m_processes.cend(); ++it) {
+        if (m_suspended.contains(it.key()) || (it.value()->nice() >= task.definitions.nice))
+            continue;
+        candidates.append(it.key());
+    }
+    // the least important and the latest tasks lose less work
+    std::sort(candidates.begin(), candidates.end(),
+              [this](const long long _first, const long long _second) {
+                  auto firstNice = m_processes[_first]->nice();
+                  auto secondNice = m_processes[_second]->nice();
+                  return (firstNice < secondNice)
+                         || ((firstNice == secondNice) && (_first > _second));
+              });
+
+    auto available = freeLimits();
+    QList<long long> victims;
+    for (auto index : candidates) {
+        if ((required.cpu <= available.cpu) && (required.memory <= available.memory))
+            break;
+        auto &limits = m_running[index].limits;
+        available.cpu += limits.cpu;
+        if (releaseMemory)
+            available.memory += limits.memory;
+        victims.append(index);
+    }
+    if ((required.cpu > available.cpu) || (required.memory > available.memory)) {
+        qCDebug(LOG_LIB) << "Task" << _index << "does not fit even after preemption";
+        return false;
+    }
+
+    qCInfo(LOG_LIB) << "Preempt tasks" << victims << "for" << _index;
+    for (auto index : victims) {
+        if (releaseMemory)
+            requeue(index);
+        else
+            suspend(index);
+    }
+
+    return true;
+}
+
+
+/**
+ * @fn launch
+ */
+void QueuedProcessManager::launch(const long long _index, const QDateTime &_time)
+{
+    qCDebug(LOG_LIB) << "Launch task" << _index << "at" << _time;
+
+    dequeue(_index);
+    // task might be forced to start before its dependencies
+    m_waiting.remove(_index);
+    auto task = m_pending.take(_index);
+    m_queueWait.record(task.queued.nsecsElapsed() / 1000);
+    qCDebug(LOG_SCHED) << "Launch task" << _index << "after" << task.queued.elapsed()
+                       << "ms in queue";
+    auto &deadline = task.definitions.deadline;
+    if (deadline.isValid() && (_time.addSecs(task.definitions.walltime) > deadline))
+        qCInfo(LOG_SCHED) << "Task" << _index << "is started too late to meet deadline"
+                          << deadline;
+
+    auto *process = new QueuedProcess(this, task.definitions, _index);
+    m_processes[_index] = process;
+    // connect to signal
+    m_connections[_index] += connect(
+        process, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+        [=](const int exitCode, const QProcess::ExitStatus exitStatus) {
+            return taskFinished(exitCode, exitStatus, _index);
+        });
+    // finished signal is not emitted if process could not be started. The connection is queued,
+    // because error might be emitted from start() while the scheduling pass is in progress
+    m_connections[_index] += connect(
+        process, &QProcess::errorOccurred, this,
+        [=](const QProcess::ProcessError error) {
+            if (error != QProcess::ProcessError::FailedToStart)
+                return;
+            qCWarning(LOG_LIB) << "Task" << _index << "could not be started";
+            return taskFinished(-1, QProcess::ExitStatus::CrashExit, _index);
+        },
+        Qt::QueuedConnection);
+    // time between fork and exec notification, it includes event loop delay
+    QElapsedTimer dispatch;
+    dispatch.start();
+    m_connections[_index] += connect(process, &QProcess::started, this, [=]() {
+        m_dispatchLatency.record(dispatch.nsecsElapsed() / 1000);
+    });
+
+    // reserve resources before start, they will be released on task removal
+    QueuedReservation reservation;
+    reservation.user = task.definitions.user;
+    reservation.limits = requiredLimits(task.limits);
+    m_running[_index] = reservation;
+    m_used.cpu += reservation.limits.cpu;
+    m_used.memory += reservation.limits.memory;
+    m_used.storage += reservation.limits.storage;
+    m_runningShare[reservation.user] += share(reservation.limits);
+    auto &running = m_userRunning[reservation.user];
+    running.tasks++;
+    running.limits.cpu += reservation.limits.cpu;
+    running.limits.memory += reservation.limits.memory;
+
+    if ((process->gang() > 0) || cpuPinning())
+        allocateCores(_index);
+    else if (!m_cores.isEmpty())
+        process->setCpuSet(sharedCores());
+
+    startProcess(process);
+    process->setStartTime(_time);
+
+    // new task changes its usage quickly, thus sampling is restarted with the shortest interval
+    auto interval = shortestUsageInterval();
+    if ((interval > 0) && (!m_usageTimer.isActive() || (m_usageTimer.remainingTime() > interval)))
+        m_usageTimer.start(static_cast<int>(interval));
+}
+
+
+/**
+ * @fn release
+ */
+void QueuedProcessManager::release(const long long _index)
+{
+    qCDebug(LOG_LIB) << "Release resources of task" << _index;
+
+    if (!m_running.contains(_index))
+        return;
+
+    auto reservation = m_running.take(_index);
+    // CPU of suspended task has been already released
+    if (!m_suspended.remove(_index))
+        m_used.cpu -= reservation.limits.cpu;
+    m_used.memory -= reservation.limits.memory;
+    m_used.storage -= reservation.limits.storage;
+    m_runningShare[reservation.user] -= share(reservation.limits);
+    auto &running = m_userRunning[reservation.user];
+    running.tasks--;
+    running.limits.cpu -= reservation.limits.cpu;
+    running.limits.memory -= reservation.limits.memory;
+    if (running.tasks == 0)
+        m_userRunning.remove(reservation.user);
+    if (m_cores.remove(_index) > 0)
+        updateCpuSets();
+}
+
+
+/**
+ * @fn resolve
+ */
+void QueuedProcessManager::resolve(const long long _index, const bool _success)
+{
+    qCDebug(LOG_LIB) << "Resolve dependencies on task" << _index << "with status" << _success;
+
+    auto dependents = m_dependents.take(_index);
+    for (auto it = dependents.cbegin(); it != dependents.cend(); ++it) {
+        // task might be already started or removed
+        if (!m_waiting.contains(it.key()))
+            continue;
+        if ((it.value() == QueuedEnums::DependencyType::AfterOk) && !_success) {
+            qCInfo(LOG_LIB) << "Dependency" << _index << "of task" << it.key() << "has failed";
+            cancel(it.key());
+            continue;
+        }
+
+        m_waiting[it.key()].remove(_index);
+        if (!m_waiting[it.key()].isEmpty())
+            continue;
+        m_waiting.remove(it.key());
+        enqueue(it.key());
+    }
+}
+
+
+/**
+ * @fn requeue
+ */
+void QueuedProcessManager::requeue(const long long _index)
+{
+    qCInfo(LOG_LIB) << "Requeue task" << _index;
+
+    auto pr = process(_index);
+    if (!pr)
+        return;
+
+    // consumed resources are charged as for finished task
+    auto definitions = pr->definitions();
+    auto reservation = m_running.value(_index);
+    reservation.limits *= pr->startTime().secsTo(currentTime());
+    addUsage(reservation.user, reservation.limits, currentTime());
+
+    // group is removed together with process, thus consumed resources are read before
+    pr->sampleUsage(QDateTime::currentDateTimeUtc());
+    auto cpuTime = pr->cpuTime();
+    auto memoryPeak = pr->memoryPeak();
+    auto ioBytes = pr->ioBytes();
+
+    pr->killChildren();
+    remove(_index);
+    // dependents still wait for this task, thus only the task itself is created again
+    create(definitions, _index);
+    emit(taskUsageReceived(_index, cpuTime, memoryPeak, ioBytes));
+    emit(taskRequeued(_index));
+}
+
+
+/**
+ * @fn reservedLimits
+ */
+QueuedLimits::Limits QueuedProcessManager::reservedLimits(const long long _index) const
+{
+    QueuedLimits::Limits reserved;
+    if (m_reservations.isEmpty())
+        return reserved;
+
+    auto task = m_pending.value(_index);
+    auto now = currentTime();
+    auto walltime = task.definitions.walltime;
+    for (auto &reservation : m_reservations) {
+        if (reservation.user == task.definitions.user)
+            continue;
+        auto start = windowStart(reservation, now);
+        if (!start.isValid())
+            continue;
+        // task which ends before window starts may use reserved resources
+        if ((walltime > 0) && (now.addSecs(walltime) <= start))
+            continue;
+
+        auto held = requiredLimits(reservation.limits);
+        // resources used by owner during window are already counted as used
+        if ((start <= now) && (reservation.user > 0)) {
+            auto running = m_userRunning.value(reservation.user).limits;
+            held.cpu = std::max(held.cpu - running.cpu, 0ll);
+            held.memory = std::max(held.memory - running.memory, 0ll);
+        }
+        reserved.cpu += held.cpu;
+        reserved.memory += held.memory;
+    }
+
+    return reserved;
+}
+
+
+/**
+ * @fn resume
+ */
+void QueuedProcessManager::resume(const long long _index)
+{
+    qCInfo(LOG_LIB) << "Resume task" << _index;
+
+    if (!m_suspended.remove(_index))
+        return;
+
+    m_used.cpu += m_running[_index].limits.cpu;
+    // cores might be given to other gang task during suspension
+    allocateCores(_index);
+    if (m_exited.contains(_index))
+        m_processes[_index]->cgroup()->sendSignal(SIGCONT);
+    else
+        m_processes[_index]->resume();
+}
+
+
+/**
+ * @fn resumeTasks
+ */
+void QueuedProcessManager::resumeTasks()
+{
+    if (m_suspended.isEmpty())
+        return;
+    qCDebug(LOG_LIB) << "Resume suspended tasks";
+
+    // pending task with higher priority should not wait for continued one
+    uint headNice = m_queue.isEmpty() ? 0 : m_pending[m_policy->next()].definitions.nice;
+    auto suspended = m_suspended.values();
+    std::sort(suspended.begin(), suspended.end(),
+              [this](const long long _first, const long long _second) {
+                  auto firstNice = m_processes[_first]->nice();
+                  auto secondNice = m_processes[_second]->nice();
+                  return (firstNice > secondNice)
+                         || ((firstNice == secondNice) && (_first < _second));
+              });
+
+    auto cpuCount = QueuedSystemInfo::cpuCount();
+    for (auto index : suspended) {
+        if (m_processes[index]->nice() < headNice)
+            break;
+        if (m_running[index].limits.cpu > cpuCount - m_used.cpu)
+            continue;
+        resume(index);
+    }
+}
+
+
+/**
+ * @fn sampleTasks
+ */
+void QueuedProcessManager::sampleTasks()
+{
+    qCDebug(LOG_LIB) << "Sample usage of" << m_processes.count() << "running tasks";
+
+    // usage is sampled by real time even if scheduler time differs
+    auto now = QDateTime::currentDateTimeUtc();
+    for (auto process : m_processes)
+        process->sampleUsage(now);
+
+    if (!m_processes.isEmpty()) {
+        // admission is based on the last samples, thus they may not be older than its interval
+        auto longest = admissionInterval() > 0 ? admissionInterval() : 86400000ll;
+        auto interval = std::min(2ll * m_usageTimer.interval(), 16 * shortestUsageInterval());
+        m_usageTimer.start(static_cast<int>(std::min(interval, longest)));
+    }
+
+    // usage might be decreased
+    if (admissionInterval() > 0)
+        start();
+}
+
+
+/**
+ * @fn share
+ */
+double QueuedProcessManager::share(const QueuedLimits::Limits &_limits)
+{
+    return static_cast<double>(_limits.cpu) / static_cast<double>(QueuedSystemInfo::cpuCount())
+           + static_cast<double>(_limits.memory)
+                 / static_cast<double>(QueuedSystemInfo::memoryCount());
+}
+
+
+/**
+ * @fn sharedCores
+ */
+QList<long long> QueuedProcessManager::sharedCores() const
+{
+    auto cores = QueuedSystemInfo::allowedCores();
+    for (auto &dedicated : m_cores) {
+        for (auto cpu : dedicated)
+            cores.removeOne(cpu);
+    }
+
+    return cores;
+}
+
+
+/**
+ * @fn shortestUsageInterval
+ */
+long long QueuedProcessManager::shortestUsageInterval() const
+{
+    if (admissionInterval() <= 0)
+        return m_usageInterval;
+    if (m_usageInterval <= 0)
+        return admissionInterval();
+
+    return std::min(m_usageInterval, admissionInterval());
+}
+
+
+/**
+ * @fn suspend
+ */
+void QueuedProcessManager::suspend(const long long _index)
+{
+    qCInfo(LOG_LIB) << "Suspend task" << _index;
+
+    if (m_suspended.contains(_index) || !m_processes.contains(_index))
+        return;
+
+    // memory is still held by stopped task, thus CPU is released only
+    m_suspended.insert(_index);
+    m_used.cpu -= m_running[_index].limits.cpu;
+    if (m_exited.contains(_index))
+        m_processes[_index]->cgroup()->sendSignal(SIGSTOP);
+    else
+        m_processes[_index]->suspend();
+    if (m_cores.remove(_index) > 0)
+        updateCpuSets();
+}
+
+
+/**
+ * @fn taskLimits
+ */
+QueuedLimits::Limits
+QueuedProcessManager::taskLimits(const QueuedProcess::QueuedProcessDefinitions &_definitions)
+{
+    auto limits = QueuedLimits::Limits(_definitions.limits);
+    if (_definitions.gang > 0)
+        limits.cpu = _definitions.gang;
+
+    return limits;
+}
+
+
+/**
+ * @fn updateCpuSets
+ */
+void QueuedProcessManager::updateCpuSets()
+{
+    qCDebug(LOG_LIB) << "Update CPU cores of shared tasks";
+
+    auto shared = sharedCores();
+    for (auto it = m_processes.cbegin(); it != m_processes.cend(); ++it) {
+        if (!m_cores.contains(it.key()))
+            it.value()->setCpuSet(shared);
+    }
+}
+
+
+/**
+ * @fn updateReservationTimer
+ */
+void QueuedProcessManager::updateReservationTimer()
+{
+    m_reservationTimer.stop();
+
+    auto now = currentTime();
+    QDateTime next;
+    for (auto &reservation : m_reservations) {
+        auto start = windowStart(reservation, now);
+        if (!start.isValid())
+            continue;
+        auto end = start.addSecs(reservation.startTime.secsTo(reservation.endTime));
+        if (!next.isValid() || (end < next))
+            next = end;
+    }
+    if (!next.isValid())
+        return;
+
+    // timer interval is limited, thus timer is restarted after a day for farther windows
+    auto interval = std::min(now.msecsTo(next), 86400000ll);
+    qCDebug(LOG_LIB) << "Next reservation window ends at" << next;
+    m_reservationTimer.start(static_cast<int>(std::max(interval, 0ll)));
+}
+
+
+/**
+ * @fn updateUsage
+ */
+void QueuedProcessManager::updateUsage(const QDateTime &_time)
+{
+    qCDebug(LOG_LIB) << "Decay usage to" << _time;
+
+    auto factor = decay(m_usageTime, _time);
+    for (auto &value : m_usage)
+        value *= factor;
+    m_usageTime = _time;
+}
+
+
+/**
+ * @fn updateWakeupTimer
+ */
+void QueuedProcessManager::updateWakeupTimer()
+{
+    m_wakeupTimer.stop();
+    if (m_delayed.isEmpty())
+        return;
+
+    // timer interval is limited, thus timer is restarted after a day for farther tasks
+    auto interval = std::min(currentTime().msecsTo(m_delayed.firstKey()), 86400000ll);
+    m_wakeupTimer.start(static_cast<int>(std::max(interval, 0ll)));
+}
+
+
+/**
+ * @fn wakeup
+ */
+void QueuedProcessManager::wakeup()
+{
+    auto now = currentTime();
+    QList<long long> ready;
+    while (!m_delayed.isEmpty() && (m_delayed.firstKey() <= now)) {
+        ready.append(m_delayed.first());
+        m_delayed.erase(m_delayed.begin());
+    }
+    updateWakeupTimer();
+    if (ready.isEmpty())
+        return;
+
+    qCDebug(LOG_SCHED) << "Tasks" << ready << "may be started now";
+    for (auto index : ready)
+        enqueue(index);
+    start();
+}
+
+
+/**
+ * @fn withinQuota
+ */
+bool QueuedProcessManager::withinQuota(const long long _index) const
+{
+    auto task = m_pending.value(_index);
+    auto user = task.definitions.user;
+    if (!m_quotas.contains(user))
+        return true;
+
+    auto quota = m_quotas[user];
+    auto running = m_userRunning.value(user);
+    auto required = requiredLimits(task.limits);
+    // zero values mean unlimited
+    bool fits = ((quota.tasks <= 0) || (running.tasks < quota.tasks))
+                && ((quota.limits.cpu <= 0)
+                    || (running.limits.cpu + required.cpu <= quota.limits.cpu))
+                && ((quota.limits.memory <= 0)
+                    || (running.limits.memory + required.memory <= quota.limits.memory));
+    if (!fits)
+        qCDebug(LOG_LIB) << "Task" << _index << "does not fit into quota of user" << user;
+
+    return fits;
+}
+
+
+/**
+ * @fn windowStart
+ */
+QDateTime QueuedProcessManager::windowStart(const QueuedCapacityReservation &_reservation,
+                                            const QDateTime &_time)
+{
+    auto duration = _reservation.startTime.secsTo(_reservation.endTime);
+    if (duration <= 0)
+        return QDateTime();
+    if (_reservation.period <= 0)
+        return (_reservation.endTime > _time) ? _reservation.startTime : QDateTime();
+    if (_time < _reservation.startTime)
+        return _reservation.startTime;
+
+    // the latest window which has started before the specified time
+    auto count = _reservation.startTime.secsTo(_time) / _reservation.period;
+    auto start = _reservation.startTime.addSecs(count * _reservation.period);
+    if (start.addSecs(duration) <= _time)
+        start = start.addSecs(_reservation.period);
+
+    return start;
 }
@@ -77,8 +77,12 @@ QDBusVariant QueuedReportInterface::Performance(const QString &from, const QStri
  */
 QDBusVariant QueuedReportInterface::Status()
 {
-    QueuedResult<QueuedStatusMap> metadata = QueuedDebug::getBuildMetaData();
+    auto data = QueuedDebug::getBuildMetaData();
     // append metadata here
+    auto statistics = m_core->schedulerStatistics();
+    for (auto it = statistics.cbegin(); it != statistics.cend(); ++it)
+        data[it.key()] = it.value();
+    QueuedResult<QueuedStatusMap> metadata = data;
 
     return QDBusVariant(QVariant::fromValue<QueuedResult<QueuedStatusMap>>(metadata));
 }
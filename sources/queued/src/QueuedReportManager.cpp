@@ -61,9 +61,10 @@ QList<QVariantHash> QueuedReportManager::performance(const QueuedCore *_core,
     qCDebug(LOG_LIB) << "Build performance report from" << _from << "to" << _to;
 
     QVariantHash params;
-    QStringList conditions;
+    // tasks which have never been started did not use any resources
+    QStringList conditions = {"(startTime NOT NULL)"};
     if (_from.isValid()) {
-        conditions += "((datetime(startTime) > datetime(:startTime)) OR (startTime IS NULL))";
+        conditions += "(datetime(startTime) > datetime(:startTime))";
         params["startTime"] = _from.toString(Qt::ISODateWithMs);
     }
     if (_to.isValid()) {
@@ -79,19 +80,7 @@ QList<QVariantHash> QueuedReportManager::performance(const QueuedCore *_core,
     // build hash first
     QHash<long long, QVariantHash> hashOutput;
     for (auto &task : tasks) {
-        QueuedLimits::Limits limits = QueuedLimits::Limits(task["limits"].toString());
-        // update values to system ones if empty
-        if (limits.cpu == 0)
-            limits.cpu = QueuedSystemInfo::cpuCount();
-        if (limits.memory == 0)
-            limits.memory = QueuedSystemInfo::memoryCount();
-        // calculate usage stats
-        long long taskTime
-            = QDateTime::fromString(task["endTime"].toString(), Qt::ISODateWithMs)
-                  .toMSecsSinceEpoch()
-              - QDateTime::fromString(task["startTime"].toString(), Qt::ISODateWithMs)
-                    .toMSecsSinceEpoch();
-        limits *= taskTime / 1000;
+        auto limits = actualUsage(task);
 
         // append
         long long userId = task.value("user").toLongLong();
@@ -103,6 +92,7 @@ QList<QVariantHash> QueuedReportManager::performance(const QueuedCore *_core,
         currentData["gpumemory"]
             = currentData.value("gpumemory", 0).toLongLong() + limits.gpumemory;
         currentData["storage"] = currentData.value("storage", 0).toLongLong() + limits.storage;
+        currentData["io"] = currentData.value("io", 0).toLongLong() + task["ioBytes"].toLongLong();
         currentData["count"] = currentData.value("count", 0).toLongLong() + 1;
         // internal fields
         currentData["user"] = userObj ? userObj->name() : "";
@@ -124,6 +114,47 @@ QList<QVariantHash> QueuedReportManager::performance(const QueuedCore *_core,
 }
 
 
+/**
+ * @fn actualUsage
+ */
+QueuedLimits::Limits QueuedReportManager::actualUsage(const QVariantHash &_task)
+{
+    auto limits = usage(_task);
+    // tasks which have been finished before usage recording have declared values only
+    if (_task["cpuTime"].isNull())
+        return limits;
+
+    auto startTime = QDateTime::fromString(_task["startTime"].toString(), Qt::ISODateWithMs);
+    auto endTime = QDateTime::fromString(_task["endTime"].toString(), Qt::ISODateWithMs);
+    limits.cpu = _task["cpuTime"].toLongLong() / 1000;
+    limits.memory = _task["memoryPeak"].toLongLong() * startTime.secsTo(endTime);
+
+    return limits;
+}
+
+
+/**
+ * @fn usage
+ */
+QueuedLimits::Limits QueuedReportManager::usage(const QVariantHash &_task)
+{
+    QueuedLimits::Limits limits = QueuedLimits::Limits(_task["limits"].toString());
+    // update values to system ones if empty
+    if (limits.cpu == 0)
+        limits.cpu = QueuedSystemInfo::cpuCount();
+    if (limits.memory == 0)
+        limits.memory = QueuedSystemInfo::memoryCount();
+    // calculate usage stats, cancelled tasks have end time but have never been started
+    auto startTime = QDateTime::fromString(_task["startTime"].toString(), Qt::ISODateWithMs);
+    auto endTime = QDateTime::fromString(_task["endTime"].toString(), Qt::ISODateWithMs);
+    if (!startTime.isValid() || !endTime.isValid())
+        return QueuedLimits::Limits(0, 0, 0, 0, 0);
+    limits *= startTime.msecsTo(endTime) / 1000;
+
+    return limits;
+}
+
+
 /**
  * @fn tasks
  */
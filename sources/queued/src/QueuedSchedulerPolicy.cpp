@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2017 Queued team
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ *
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+/**
+ * @file QueuedSchedulerPolicy.cpp
+ * Source code of queued library
+ * @author Queued team
+ * @copyright MIT
+ * @bug https://github.com/arcan1s/queued/issues
+ */
+
+
+#include <queued/Queued.h>
+
+#include <limits>
+
+
+/**
+ * @class QueuedSchedulerPolicy
+ */
+/**
+ * @fn QueuedSchedulerPolicy
+ */
+QueuedSchedulerPolicy::QueuedSchedulerPolicy(const QueuedProcessManager *_manager)
+    : m_manager(_manager)
+{
+    qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
+}
+
+
+/**
+ * @fn ~QueuedSchedulerPolicy
+ */
+QueuedSchedulerPolicy::~QueuedSchedulerPolicy()
+{
+    qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
+}
+
+
+/**
+ * @fn create
+ */
+QueuedSchedulerPolicy *QueuedSchedulerPolicy::create(const QueuedEnums::SchedulerPolicy _policy,
+                                                     const QueuedProcessManager *_manager)
+{
+    qCDebug(LOG_LIB) << "Create scheduler policy" << static_cast<int>(_policy);
+
+    switch (_policy) {
+    case QueuedEnums::SchedulerPolicy::FIFO:
+        return new QueuedFifoPolicy(_manager);
+    case QueuedEnums::SchedulerPolicy::FairShare:
+        return new QueuedFairSharePolicy(_manager);
+    case QueuedEnums::SchedulerPolicy::Backfill:
+        return new QueuedBackfillPolicy(_manager);
+    case QueuedEnums::SchedulerPolicy::ShortestJobFirst:
+        return new QueuedShortestJobFirstPolicy(_manager);
+    case QueuedEnums::SchedulerPolicy::Deadline:
+        return new QueuedDeadlinePolicy(_manager);
+    case QueuedEnums::SchedulerPolicy::Invalid:
+        qCWarning(LOG_LIB) << "Invalid scheduler policy, fallback to priority one";
+        break;
+    case QueuedEnums::SchedulerPolicy::Priority:
+        break;
+    }
+
+    return new QueuedPriorityPolicy(_manager);
+}
+
+
+/**
+ * @fn backfill
+ */
+bool QueuedSchedulerPolicy::backfill() const
+{
+    return false;
+}
+
+
+/**
+ * @fn next
+ */
+long long QueuedSchedulerPolicy::next() const
+{
+    return m_manager->pendingQueue().firstKey().index;
+}
+
+
+/**
+ * @class QueuedFifoPolicy
+ */
+/**
+ * @fn rank
+ */
+long long QueuedFifoPolicy::rank(const QueuedProcess::QueuedProcessDefinitions &) const
+{
+    return 0;
+}
+
+
+/**
+ * @fn type
+ */
+QueuedEnums::SchedulerPolicy QueuedFifoPolicy::type() const
+{
+    return QueuedEnums::SchedulerPolicy::FIFO;
+}
+
+
+/**
+ * @class QueuedPriorityPolicy
+ */
+/**
+ * @fn rank
+ */
+long long
+QueuedPriorityPolicy::rank(const QueuedProcess::QueuedProcessDefinitions &_definitions) const
+{
+    return -static_cast<long long>(_definitions.nice);
+}
+
+
+/**
+ * @fn type
+ */
+QueuedEnums::SchedulerPolicy QueuedPriorityPolicy::type() const
+{
+    return QueuedEnums::SchedulerPolicy::Priority;
+}
+
+
+/**
+ * @class QueuedBackfillPolicy
+ */
+/**
+ * @fn backfill
+ */
+bool QueuedBackfillPolicy::backfill() const
+{
+    return true;
+}
+
+
+/**
+ * @fn type
+ */
+QueuedEnums::SchedulerPolicy QueuedBackfillPolicy::type() const
+{
+    return QueuedEnums::SchedulerPolicy::Backfill;
+}
+
+
+/**
+ * @class QueuedFairSharePolicy
+ */
+/**
+ * @fn next
+ */
+long long QueuedFairSharePolicy::next() const
+{
+    auto &queues = m_manager->userQueues();
+
+    // compare first tasks of each user, nice level is still more important than usage
+    QueuedProcessManager::QueuedPendingKey selectedKey;
+    double selectedUsage = 0.0;
+    for (auto it = queues.cbegin(); it != queues.cend(); ++it) {
+        auto key = it.value().firstKey();
+        auto value = m_manager->usage(it.key());
+        if (selectedKey.index != -1) {
+            if (key.rank != selectedKey.rank) {
+                if (key.rank > selectedKey.rank)
+                    continue;
+            } else if ((value > selectedUsage)
+                       || ((value == selectedUsage) && (key.index > selectedKey.index))) {
+                continue;
+            }
+        }
+        selectedKey = key;
+        selectedUsage = value;
+    }
+
+    return selectedKey.index;
+}
+
+
+/**
+ * @fn type
+ */
+QueuedEnums::SchedulerPolicy QueuedFairSharePolicy::type() const
+{
+    return QueuedEnums::SchedulerPolicy::FairShare;
+}
+
+
+/**
+ * @class QueuedShortestJobFirstPolicy
+ */
+/**
+ * @fn rank
+ */
+long long QueuedShortestJobFirstPolicy::rank(
+    const QueuedProcess::QueuedProcessDefinitions &_definitions) const
+{
+    return _definitions.walltime > 0 ? _definitions.walltime
+                                     : std::numeric_limits<long long>::max();
+}
+
+
+/**
+ * @fn type
+ */
+QueuedEnums::SchedulerPolicy QueuedShortestJobFirstPolicy::type() const
+{
+    return QueuedEnums::SchedulerPolicy::ShortestJobFirst;
+}
+
+
+/**
+ * @class QueuedDeadlinePolicy
+ */
+/**
+ * @fn rank
+ */
+long long
+QueuedDeadlinePolicy::rank(const QueuedProcess::QueuedProcessDefinitions &_definitions) const
+{
+    return _definitions.deadline.isValid()
+               ? _definitions.deadline.toSecsSinceEpoch() - _definitions.walltime
+               : std::numeric_limits<long long>::max();
+}
+
+
+/**
+ * @fn type
+ */
+QueuedEnums::SchedulerPolicy QueuedDeadlinePolicy::type() const
+{
+    return QueuedEnums::SchedulerPolicy::Deadline;
+}
@@ -23,19 +23,64 @@
 
 #include <queued/Queued.h>
 
+#include <QDir>
 #include <QThread>
 
 extern "C" {
+#include <sched.h>
 #include <sys/sysinfo.h>
 }
 
 
+/**
+ * @brief system size which is used instead of actual one if set
+ */
+static QueuedLimits::Limits systemSize;
+
+
+/**
+ * @fn allowedCores
+ */
+QList<long long> QueuedSystemInfo::allowedCores()
+{
+    QList<long long> cores;
+    if (systemSize.cpu > 0) {
+        for (long long cpu = 0; cpu < systemSize.cpu; cpu++)
+            cores.append(cpu);
+        return cores;
+    }
+
+    static QList<long long> allowed;
+    if (!allowed.isEmpty())
+        return allowed;
+
+    // core numbers might be sparse if some of them are offline or not allowed for daemon
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (::sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &mask))
+                cores.append(cpu);
+        }
+    }
+    if (cores.isEmpty()) {
+        qCWarning(LOG_LIB) << "Could not read affinity mask, use all cores";
+        for (long long cpu = 0; cpu < cpuCount(); cpu++)
+            cores.append(cpu);
+    }
+    qCInfo(LOG_LIB) << "Found allowed CPU cores" << cores;
+    allowed = cores;
+
+    return allowed;
+}
+
+
 /**
  * @fn cpuCount
  */
 long long QueuedSystemInfo::cpuCount()
 {
-    return QThread::idealThreadCount();
+    return (systemSize.cpu > 0) ? systemSize.cpu : QThread::idealThreadCount();
 }
 
 
@@ -58,6 +103,9 @@ double QueuedSystemInfo::cpuWeight(const long long _cpu)
  */
 long long QueuedSystemInfo::memoryCount()
 {
+    if (systemSize.memory > 0)
+        return systemSize.memory;
+
     struct sysinfo info;
     if (::sysinfo(&info) != 0)
         throw QueuedConfigurationException("Count not get memory information");
@@ -78,3 +126,75 @@ double QueuedSystemInfo::memoryWeight(const long long _memory)
     else
         return 1.0;
 }
+
+
+/**
+ * @fn numaNodes
+ */
+QMap<long long, QList<long long>> QueuedSystemInfo::numaNodes()
+{
+    if (systemSize.cpu > 0)
+        return {{0, allowedCores()}};
+
+    static QMap<long long, QList<long long>> nodes;
+    if (!nodes.isEmpty())
+        return nodes;
+
+    auto allowed = allowedCores();
+    QDir root("/sys/devices/system/node");
+    auto directories = root.entryList({"node*"}, QDir::Dirs | QDir::NoDotAndDotDot);
+    for (auto &directory : directories) {
+        bool status = false;
+        auto node = directory.mid(4).toLongLong(&status);
+        QFile file(QDir(root.filePath(directory)).filePath("cpulist"));
+        if (!status || !file.open(QIODevice::ReadOnly | QFile::Text))
+            continue;
+        // cores which are not allowed for daemon could not be set to task groups
+        QList<long long> cores;
+        for (auto cpu : parseRangeList(file.readAll())) {
+            if (allowed.contains(cpu))
+                cores.append(cpu);
+        }
+        if (!cores.isEmpty())
+            nodes[node] = cores;
+    }
+    // kernel might be built without NUMA support
+    if (nodes.isEmpty()) {
+        qCInfo(LOG_LIB) << "Could not read NUMA topology, use single node";
+        nodes[0] = allowed;
+    }
+    qCInfo(LOG_LIB) << "Found NUMA nodes" << nodes;
+
+    return nodes;
+}
+
+
+/**
+ * @fn parseRangeList
+ */
+QList<long long> QueuedSystemInfo::parseRangeList(const QString &_list)
+{
+    QList<long long> values;
+
+    auto ranges = _list.trimmed().split(',', QString::SkipEmptyParts);
+    for (auto &range : ranges) {
+        auto bounds = range.split('-');
+        for (auto value = bounds.first().toLongLong(); value <= bounds.last().toLongLong();
+             value++)
+            values.append(value);
+    }
+
+    return values;
+}
+
+
+/**
+ * @fn setSystemSize
+ */
+void QueuedSystemInfo::setSystemSize(const long long _cpu, const long long _memory)
+{
+    qCDebug(LOG_LIB) << "Override system size to" << _cpu << "cores and" << _memory << "memory";
+
+    systemSize.cpu = std::max(_cpu, 0ll);
+    systemSize.memory = std::max(_memory, 0ll);
+}
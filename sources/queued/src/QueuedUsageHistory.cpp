@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2017 Queued team
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ *
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+/**
+ * @file QueuedUsageHistory.cpp
+ * Source code of queued library
+ * @author Queued team
+ * @copyright MIT
+ * @bug https://github.com/arcan1s/queued/issues
+ */
+
+
+#include <queued/Queued.h>
+
+
+/**
+ * @fn append
+ */
+void QueuedUsageHistory::append(const QueuedUsagePoint &_point)
+{
+    if (m_points.count() < CAPACITY) {
+        m_points.append(_point);
+    } else {
+        m_points[m_head] = _point;
+        m_head = (m_head + 1) % CAPACITY;
+    }
+}
+
+
+/**
+ * @fn count
+ */
+int QueuedUsageHistory::count() const
+{
+    return m_points.count();
+}
+
+
+/**
+ * @fn last
+ */
+QueuedUsageHistory::QueuedUsagePoint QueuedUsageHistory::last() const
+{
+    if (m_points.isEmpty())
+        return QueuedUsagePoint();
+
+    // head points to the next one after the newest sample
+    return m_points.at((m_head + m_points.count() - 1) % m_points.count());
+}
+
+
+/**
+ * @fn points
+ */
+QVector<QueuedUsageHistory::QueuedUsagePoint> QueuedUsageHistory::points() const
+{
+    QVector<QueuedUsagePoint> points;
+    points.reserve(m_points.count());
+    for (int i = 0; i < m_points.count(); i++)
+        points.append(m_points.at((m_head + i) % m_points.count()));
+
+    return points;
+}
+
+
+/**
+ * @fn toString
+ */
+QString QueuedUsageHistory::toString(const QueuedUsagePoint &_point)
+{
+    return QString("%1 %2 %3 %4 %5 %6")
+        .arg(QDateTime::fromMSecsSinceEpoch(_point.time, Qt::UTC).toString(Qt::ISODateWithMs))
+        .arg(_point.cpu, 0, 'f', 2)
+        .arg(_point.memory)
+        .arg(_point.memoryPeak)
+        .arg(_point.io)
+        .arg(_point.pids);
+}
+
+
+/**
+ * @fn toStringList
+ */
+QStringList QueuedUsageHistory::toStringList() const
+{
+    QStringList output;
+    for (auto &point : points())
+        output.append(toString(point));
+
+    return output;
+}
@@ -169,6 +169,15 @@ QueuedLimits::Limits QueuedUser::nativeLimits() const
 }
 
 
+/**
+ * @fn nativeQuota
+ */
+QueuedLimits::Limits QueuedUser::nativeQuota() const
+{
+    return QueuedLimits::Limits(quota());
+}
+
+
 /**
  * @fn password
  */
@@ -205,6 +214,24 @@ QString QueuedUser::limits() const
 }
 
 
+/**
+ * @fn maxTasks
+ */
+long long QueuedUser::maxTasks() const
+{
+    return m_definitions.maxTasks;
+}
+
+
+/**
+ * @fn quota
+ */
+QString QueuedUser::quota() const
+{
+    return m_definitions.quota;
+}
+
+
 /**
  * @fn setEmail
  */
@@ -271,6 +298,28 @@ void QueuedUser::setLimits(const QString &_limits)
 }
 
 
+/**
+ * @fn setMaxTasks
+ */
+void QueuedUser::setMaxTasks(const long long _maxTasks)
+{
+    qCDebug(LOG_LIB) << "New user max tasks" << _maxTasks;
+
+    m_definitions.maxTasks = _maxTasks;
+}
+
+
+/**
+ * @fn setQuota
+ */
+void QueuedUser::setQuota(const QString &_quota)
+{
+    qCDebug(LOG_LIB) << "New user quota" << _quota;
+
+    m_definitions.quota = _quota;
+}
+
+
 /**
  * @fn operator==
  */
@@ -67,6 +67,8 @@ QueuedUserManager::parseDefinitions(const QVariantHash &_properties)
     defs.permissions = _properties["permissions"].toUInt();
     defs.priority = _properties["priority"].toUInt();
     defs.limits = _properties["limits"].toString();
+    defs.maxTasks = _properties["maxTasks"].toLongLong();
+    defs.quota = _properties["quota"].toString();
 
     return defs;
 }
@@ -24,6 +24,7 @@
 #include "QueuedctlOption.h"
 #include "QueuedctlPermissions.h"
 #include "QueuedctlPlugins.h"
+#include "QueuedctlReservation.h"
 #include "QueuedctlTask.h"
 #include "QueuedctlUser.h"
 
@@ -152,6 +153,12 @@ void QueuedctlCommon::preprocess(const QStringList &_args, QCommandLineParser &_
     case QueuedctlArgument::Report:
         QueuedctlUser::parserReport(_parser);
         break;
+    case QueuedctlArgument::ReservationAdd:
+        QueuedctlReservation::parserAdd(_parser);
+        break;
+    case QueuedctlArgument::ReservationRemove:
+        QueuedctlReservation::parserRemove(_parser);
+        break;
     case QueuedctlArgument::Status:
         break;
     case QueuedctlArgument::TaskAdd:
@@ -273,6 +280,14 @@ QueuedctlCommon::process(QCommandLineParser &_parser, const QString &_cache, con
         result = QueuedctlUser::getReport(_parser, token);
         break;
     }
+    case QueuedctlArgument::ReservationAdd: {
+        result = QueuedctlReservation::addReservation(_parser, token);
+        break;
+    }
+    case QueuedctlArgument::ReservationRemove: {
+        result = QueuedctlReservation::removeReservation(args.at(1).toLongLong(), token);
+        break;
+    }
     case QueuedctlArgument::Status: {
         auto res = QueuedCoreAdaptor::getStatus();
         res.match(
@@ -285,7 +300,9 @@ QueuedctlCommon::process(QCommandLineParser &_parser, const QString &_cache, con
     }
     case QueuedctlArgument::TaskAdd: {
         auto definitions = QueuedctlTask::getDefinitions(_parser, false, token);
-        result = QueuedctlTask::addTask(definitions, token);
+        auto count = _parser.value("array").toLongLong();
+        result = (count > 0) ? QueuedctlTask::addTaskArray(definitions, count, token)
+                             : QueuedctlTask::addTask(definitions, token);
         break;
     }
     case QueuedctlArgument::TaskGet: {
@@ -36,6 +36,8 @@ enum class QueuedctlArgument {
     PluginRemove,
     PluginSpecification,
     Report,
+    ReservationAdd,
+    ReservationRemove,
     Status,
     TaskAdd,
     TaskGet,
@@ -69,6 +71,9 @@ const QHash<QString, QueuedctlArgumentInfo> QueuedctlArguments
        {"plugin-options", {QueuedctlArgument::PluginOptions, "Get plugin options.", 2}},
        {"plugin-remove", {QueuedctlArgument::PluginRemove, "Removes plugin to load.", 2}},
        {"report", {QueuedctlArgument::Report, "Shows usage report.", 1}},
+       {"reservation-add", {QueuedctlArgument::ReservationAdd, "Reserves resources.", 1}},
+       {"reservation-remove",
+        {QueuedctlArgument::ReservationRemove, "Removes resources reservation.", 2}},
        {"status", {QueuedctlArgument::Status, "Server status.", 1}},
        {"task-add", {QueuedctlArgument::TaskAdd, "Adds new task.", 2}},
        {"task-get", {QueuedctlArgument::TaskGet, "Gets task properties.", 3}},
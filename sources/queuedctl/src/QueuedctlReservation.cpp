@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2017 Queued team
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ *
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+
+
+#include "QueuedctlReservation.h"
+#include "QueuedctlCommon.h"
+
+#include <queued/Queued.h>
+
+
+QueuedctlCommon::QueuedctlResult
+QueuedctlReservation::addReservation(const QCommandLineParser &_parser, const QString &_token)
+{
+    QueuedctlCommon::QueuedctlResult output;
+
+    // window without user is maintenance window
+    long long userId = 0;
+    if (!_parser.value("user").isEmpty()) {
+        auto userIdRes = QueuedCoreAdaptor::getUserId(_parser.value("user"), _token);
+        userIdRes.match(
+            [&userId](const long long val) { userId = val; },
+            [&output](const QueuedError &err) { output.output = err.message().c_str(); });
+        if (userId <= 0)
+            return output;
+    }
+    QueuedLimits::Limits limits(_parser.value("cpu").toLongLong(), 0,
+                                QueuedLimits::convertMemory(_parser.value("memory")), 0, 0);
+    QDateTime start = QDateTime::fromString(_parser.value("start"), Qt::ISODateWithMs);
+    QDateTime end = QDateTime::fromString(_parser.value("end"), Qt::ISODateWithMs);
+    long long period = _parser.value("period").toLongLong();
+    qCDebug(LOG_APP) << "Add reservation for user" << userId << "from" << start << "to" << end;
+
+    auto res = QueuedCoreAdaptor::sendReservationAdd(userId, limits, start, end, period, _token);
+    res.match(
+        [&output](const long long val) {
+            output.status = (val > 0);
+            output.output = QString::number(val);
+        },
+        [&output](const QueuedError &err) { output.output = err.message().c_str(); });
+
+    return output;
+}
+
+
+void QueuedctlReservation::parserAdd(QCommandLineParser &_parser)
+{
+    // user
+    QCommandLineOption userOption("user", "User who may use reserved resources.", "user", "");
+    _parser.addOption(userOption);
+    // cpu
+    QCommandLineOption cpuOption("cpu", "Reserved CPU cores, 0 for all cores.", "cpu", "0");
+    _parser.addOption(cpuOption);
+    // memory
+    QCommandLineOption memoryOption("memory", "Reserved memory, 0 for all memory.", "memory",
+                                    "0");
+    _parser.addOption(memoryOption);
+    // window
+    QCommandLineOption startOption("start", "Window start in ISO format.", "start", "");
+    _parser.addOption(startOption);
+    QCommandLineOption endOption("end", "Window end in ISO format.", "end", "");
+    _parser.addOption(endOption);
+    // period
+    QCommandLineOption periodOption("period", "Window repeat period in seconds.", "period", "0");
+    _parser.addOption(periodOption);
+}
+
+
+void QueuedctlReservation::parserRemove(QCommandLineParser &_parser)
+{
+    _parser.addPositionalArgument("id", "Reservation ID.", "<id>");
+}
+
+
+QueuedctlCommon::QueuedctlResult QueuedctlReservation::removeReservation(const long long _id,
+                                                                         const QString &_token)
+{
+    qCDebug(LOG_APP) << "Remove reservation" << _id;
+
+    auto res = QueuedCoreAdaptor::sendReservationRemove(_id, _token);
+
+    QueuedctlCommon::QueuedctlResult output;
+    res.match([&output](const bool val) { output.status = val; },
+              [&output](const QueuedError &err) { output.output = err.message().c_str(); });
+
+    return output;
+}
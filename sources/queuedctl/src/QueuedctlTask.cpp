@@ -46,6 +46,29 @@ QueuedctlTask::addTask(const QueuedProcess::QueuedProcessDefinitions &_definitio
 }
 
 
+QueuedctlCommon::QueuedctlResult
+QueuedctlTask::addTaskArray(const QueuedProcess::QueuedProcessDefinitions &_definitions,
+                            const long long _count, const QString &_token)
+{
+    qCDebug(LOG_APP) << "Add" << _count << "tasks" << _definitions.command;
+
+    auto res = QueuedCoreAdaptor::sendTaskAddArray(_definitions, _count, _token);
+
+    QueuedctlCommon::QueuedctlResult output;
+    res.match(
+        [&output](const QList<long long> &val) {
+            output.status = !val.isEmpty();
+            QStringList ids;
+            for (auto id : val)
+                ids.append(QString::number(id));
+            output.output = ids.join('\n');
+        },
+        [&output](const QueuedError &err) { output.output = err.message().c_str(); });
+
+    return output;
+}
+
+
 QueuedProcess::QueuedProcessDefinitions
 QueuedctlTask::getDefinitions(const QCommandLineParser &_parser, const bool _expandAll,
                               const QString &_token)
@@ -76,6 +99,8 @@ QueuedctlTask::getDefinitions(const QCommandLineParser &_parser, const bool _exp
                                 QueuedLimits::convertMemory(_parser.value("limit-gpumemory")),
                                 QueuedLimits::convertMemory(_parser.value("limit-storage")));
     definitions.limits = limits.toString();
+    definitions.walltime = _parser.value("walltime").toLongLong();
+    definitions.gang = _parser.value("gang").toUInt();
 
     // all options
     if (_expandAll) {
@@ -87,6 +112,15 @@ QueuedctlTask::getDefinitions(const QCommandLineParser &_parser, const bool _exp
     } else {
         // queuedctl -- task-add /path/to/application
         definitions.command = QFileInfo(_parser.positionalArguments().at(1)).absoluteFilePath();
+        // dependencies can be set on task creation only
+        for (auto &dependency : _parser.values("dependency")) {
+            if (!dependency.isEmpty())
+                definitions.dependencies.append(
+                    QueuedProcess::QueuedProcessDependency(dependency));
+        }
+        definitions.startAfter
+            = QDateTime::fromString(_parser.value("start-after"), Qt::ISODateWithMs);
+        definitions.deadline = QDateTime::fromString(_parser.value("deadline"), Qt::ISODateWithMs);
     }
 
     return definitions;
@@ -181,6 +215,31 @@ void QueuedctlTask::parserAdd(QCommandLineParser &_parser)
     // storage limit
     QCommandLineOption storageOption("limit-storage", "Task storage limit.", "limit-storage", "0");
     _parser.addOption(storageOption);
+    // walltime
+    QCommandLineOption walltimeOption("walltime", "Task estimated run time in seconds.",
+                                      "walltime", "0");
+    _parser.addOption(walltimeOption);
+    // gang
+    QCommandLineOption gangOption(
+        "gang", "Number of cooperating processes which require dedicated CPU cores.", "gang", "0");
+    _parser.addOption(gangOption);
+    // start after
+    QCommandLineOption startAfterOption("start-after", "Task may not start before this time.",
+                                        "start-after", "");
+    _parser.addOption(startAfterOption);
+    // deadline
+    QCommandLineOption deadlineOption("deadline", "Task should be finished by this time.",
+                                      "deadline", "");
+    _parser.addOption(deadlineOption);
+    // dependencies
+    QCommandLineOption dependencyOption(
+        "dependency", "Task dependency in afterok:id or afterany:id format.", "dependency", "");
+    _parser.addOption(dependencyOption);
+    // array
+    QCommandLineOption arrayOption(
+        "array", "Number of tasks to add, ${QUEUED_ARRAY_INDEX} is replaced by task position.",
+        "array", "0");
+    _parser.addOption(arrayOption);
 }
 
 
@@ -252,6 +311,10 @@ void QueuedctlTask::parserSet(QCommandLineParser &_parser)
     // storage limit
     QCommandLineOption storageOption("limit-storage", "Task storage limit.", "limit-storage", "-1");
     _parser.addOption(storageOption);
+    // walltime
+    QCommandLineOption walltimeOption("walltime", "Task estimated run time in seconds.",
+                                      "walltime", "-1");
+    _parser.addOption(walltimeOption);
 }
 
 
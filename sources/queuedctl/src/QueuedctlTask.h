@@ -28,6 +28,9 @@ namespace QueuedctlTask
 {
 QueuedctlCommon::QueuedctlResult
 addTask(const QueuedProcess::QueuedProcessDefinitions &_definitions, const QString &_token);
+QueuedctlCommon::QueuedctlResult
+addTaskArray(const QueuedProcess::QueuedProcessDefinitions &_definitions, const long long _count,
+             const QString &_token);
 QueuedProcess::QueuedProcessDefinitions
 getDefinitions(const QCommandLineParser &_parser, const bool _expandAll, const QString &_token);
 QueuedctlCommon::QueuedctlResult getTask(const long long _id, const QString &_property,
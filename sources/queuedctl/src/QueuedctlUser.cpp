@@ -96,6 +96,12 @@ QueuedUser::QueuedUserDefinitions QueuedctlUser::getDefinitions(const QCommandLi
     // all options
     if (_expandAll) {
         definitions.name = _parser.value("name");
+        // quota is changed by separate request, negative values are not changed
+        definitions.maxTasks = _parser.value("max-tasks").toLongLong();
+        QueuedLimits::Limits quota(_parser.value("quota-cpu").toLongLong(), 0,
+                                   QueuedLimits::convertMemory(_parser.value("quota-memory")), 0,
+                                   0);
+        definitions.quota = quota.toString();
     } else {
         definitions.permissions = _parser.value("access").toUInt();
         // queuedctl -- user-add username
@@ -276,6 +282,17 @@ void QueuedctlUser::parserSet(QCommandLineParser &_parser)
     // storage limit
     QCommandLineOption storageOption("limit-storage", "User storage limit.", "limit-storage", "0");
     _parser.addOption(storageOption);
+    // max running tasks
+    QCommandLineOption maxTasksOption("max-tasks", "User max running tasks.", "max-tasks", "-1");
+    _parser.addOption(maxTasksOption);
+    // cpu quota
+    QCommandLineOption quotaCpuOption("quota-cpu", "User CPU quota of running tasks.",
+                                      "quota-cpu", "-1");
+    _parser.addOption(quotaCpuOption);
+    // memory quota
+    QCommandLineOption quotaMemoryOption("quota-memory", "User memory quota of running tasks.",
+                                         "quota-memory", "-1");
+    _parser.addOption(quotaMemoryOption);
 }
 
 
@@ -291,5 +308,16 @@ QueuedctlUser::setUser(const long long _id, const QueuedUser::QueuedUserDefiniti
     res.match([&output](const bool val) { output.status = val; },
               [&output](const QueuedError &err) { output.output = err.message().c_str(); });
 
+    // quota
+    QueuedLimits::Limits quota(_definitions.quota);
+    if (!output.status || ((_definitions.maxTasks < 0) && (quota.cpu < 0) && (quota.memory < 0)))
+        return output;
+    res = QueuedCoreAdaptor::sendUserQuotaEdit(_id, _definitions.maxTasks, quota, _token);
+    res.match([&output](const bool val) { output.status = val; },
+              [&output](const QueuedError &err) {
+                  output.status = false;
+                  output.output = err.message().c_str();
+              });
+
     return output;
 }